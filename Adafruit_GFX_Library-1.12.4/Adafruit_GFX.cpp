@@ -89,6 +89,9 @@ inline uint8_t *pgm_read_bitmap_ptr(const GFXfont *gfxFont) {
 #ifndef min
 #define min(a, b) (((a) < (b)) ? (a) : (b))
 #endif
+#ifndef max
+#define max(a, b) (((a) > (b)) ? (a) : (b))
+#endif
 
 #ifndef _swap_int16_t
 #define _swap_int16_t(a, b)                                                    \
@@ -117,6 +120,11 @@ Adafruit_GFX::Adafruit_GFX(int16_t w, int16_t h) : WIDTH(w), HEIGHT(h) {
   wrap = true;
   _cp437 = false;
   gfxFont = NULL;
+  gfxFontRLE = false;
+  resetClipRect();
+  dirtyHold = 0;
+  clearDirty();
+  markDirty(0, 0, WIDTH, HEIGHT); // Framebuffer contents not yet on display
 }
 
 /**************************************************************************/
@@ -158,6 +166,9 @@ void Adafruit_GFX::writeLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
     ystep = -1;
   }
 
+  if (!clipLine(steep, &x0, &y0, &x1, &err, dy, ystep))
+    return;
+
   for (; x0 <= x1; x0++) {
     if (steep) {
       writePixel(y0, x0, color);
@@ -264,9 +275,12 @@ void Adafruit_GFX::endWrite() {}
 /**************************************************************************/
 void Adafruit_GFX::drawFastVLine(int16_t x, int16_t y, int16_t h,
                                  uint16_t color) {
+  if (!startPrimitive(x, y, 1, h))
+    return;
   startWrite();
   writeLine(x, y, x, y + h - 1, color);
   endWrite();
+  endPrimitive();
 }
 
 /**************************************************************************/
@@ -281,9 +295,12 @@ void Adafruit_GFX::drawFastVLine(int16_t x, int16_t y, int16_t h,
 /**************************************************************************/
 void Adafruit_GFX::drawFastHLine(int16_t x, int16_t y, int16_t w,
                                  uint16_t color) {
+  if (!startPrimitive(x, y, w, 1))
+    return;
   startWrite();
   writeLine(x, y, x + w - 1, y, color);
   endWrite();
+  endPrimitive();
 }
 
 /**************************************************************************/
@@ -299,11 +316,14 @@ void Adafruit_GFX::drawFastHLine(int16_t x, int16_t y, int16_t w,
 /**************************************************************************/
 void Adafruit_GFX::fillRect(int16_t x, int16_t y, int16_t w, int16_t h,
                             uint16_t color) {
+  if (!startPrimitive(x, y, w, h))
+    return;
   startWrite();
   for (int16_t i = x; i < x + w; i++) {
     writeFastVLine(i, y, h, color);
   }
   endWrite();
+  endPrimitive();
 }
 
 /**************************************************************************/
@@ -329,6 +349,9 @@ void Adafruit_GFX::fillScreen(uint16_t color) {
 /**************************************************************************/
 void Adafruit_GFX::drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
                             uint16_t color) {
+  if (!startPrimitive(min(x0, x1), min(y0, y1), abs(x1 - x0) + 1,
+                      abs(y1 - y0) + 1))
+    return;
   // Update in subclasses if desired!
   if (x0 == x1) {
     if (y0 > y1)
@@ -343,6 +366,7 @@ void Adafruit_GFX::drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
     writeLine(x0, y0, x1, y1, color);
     endWrite();
   }
+  endPrimitive();
 }
 
 /**************************************************************************/
@@ -471,6 +495,9 @@ void Adafruit_GFX::fillEllipse(int16_t x0, int16_t y0, int16_t rw, int16_t rh,
 /**************************************************************************/
 void Adafruit_GFX::drawCircle(int16_t x0, int16_t y0, int16_t r,
                               uint16_t color) {
+  bool held = (r >= 0); // Else each line drawn marks itself
+  if (held && !startPrimitive(x0 - r, y0 - r, 2 * r + 1, 2 * r + 1))
+    return;
 #if defined(ESP8266)
   yield();
 #endif
@@ -506,6 +533,8 @@ void Adafruit_GFX::drawCircle(int16_t x0, int16_t y0, int16_t r,
     writePixel(x0 - y, y0 - x, color);
   }
   endWrite();
+  if (held)
+    endPrimitive();
 }
 
 /**************************************************************************/
@@ -521,6 +550,9 @@ void Adafruit_GFX::drawCircle(int16_t x0, int16_t y0, int16_t r,
 /**************************************************************************/
 void Adafruit_GFX::drawCircleHelper(int16_t x0, int16_t y0, int16_t r,
                                     uint8_t cornername, uint16_t color) {
+  bool held = (r >= 0); // Else each line drawn marks itself
+  if (held && !startPrimitive(x0 - r, y0 - r, 2 * r + 1, 2 * r + 1))
+    return;
   int16_t f = 1 - r;
   int16_t ddF_x = 1;
   int16_t ddF_y = -2 * r;
@@ -553,6 +585,8 @@ void Adafruit_GFX::drawCircleHelper(int16_t x0, int16_t y0, int16_t r,
       writePixel(x0 - x, y0 - y, color);
     }
   }
+  if (held)
+    endPrimitive();
 }
 
 /**************************************************************************/
@@ -566,10 +600,15 @@ void Adafruit_GFX::drawCircleHelper(int16_t x0, int16_t y0, int16_t r,
 /**************************************************************************/
 void Adafruit_GFX::fillCircle(int16_t x0, int16_t y0, int16_t r,
                               uint16_t color) {
+  bool held = (r >= 0); // Else each line drawn marks itself
+  if (held && !startPrimitive(x0 - r, y0 - r, 2 * r + 1, 2 * r + 1))
+    return;
   startWrite();
   writeFastVLine(x0, y0 - r, 2 * r + 1, color);
   fillCircleHelper(x0, y0, r, 3, 0, color);
   endWrite();
+  if (held)
+    endPrimitive();
 }
 
 /**************************************************************************/
@@ -587,6 +626,9 @@ void Adafruit_GFX::fillCircle(int16_t x0, int16_t y0, int16_t r,
 void Adafruit_GFX::fillCircleHelper(int16_t x0, int16_t y0, int16_t r,
                                     uint8_t corners, int16_t delta,
                                     uint16_t color) {
+  bool held = (r >= 0) && (delta >= 0); // Else each line drawn marks itself
+  if (held && !startPrimitive(x0 - r, y0 - r, 2 * r + 1, 2 * r + 1 + delta))
+    return;
 
   int16_t f = 1 - r;
   int16_t ddF_x = 1;
@@ -624,6 +666,8 @@ void Adafruit_GFX::fillCircleHelper(int16_t x0, int16_t y0, int16_t r,
     }
     px = x;
   }
+  if (held)
+    endPrimitive();
 }
 
 /**************************************************************************/
@@ -638,12 +682,18 @@ void Adafruit_GFX::fillCircleHelper(int16_t x0, int16_t y0, int16_t r,
 /**************************************************************************/
 void Adafruit_GFX::drawRect(int16_t x, int16_t y, int16_t w, int16_t h,
                             uint16_t color) {
+  // Degenerate sizes draw outside the box; then each line marks itself
+  bool held = (w > 0) && (h > 0);
+  if (held && !startPrimitive(x, y, w, h))
+    return;
   startWrite();
   writeFastHLine(x, y, w, color);
   writeFastHLine(x, y + h - 1, w, color);
   writeFastVLine(x, y, h, color);
   writeFastVLine(x + w - 1, y, h, color);
   endWrite();
+  if (held)
+    endPrimitive();
 }
 
 /**************************************************************************/
@@ -662,6 +712,10 @@ void Adafruit_GFX::drawRoundRect(int16_t x, int16_t y, int16_t w, int16_t h,
   int16_t max_radius = ((w < h) ? w : h) / 2; // 1/2 minor axis
   if (r > max_radius)
     r = max_radius;
+  // Degenerate sizes draw outside the box; then each line marks itself
+  bool held = (w > 0) && (h > 0) && (r >= 0);
+  if (held && !startPrimitive(x, y, w, h))
+    return;
   // smarter version
   startWrite();
   writeFastHLine(x + r, y, w - 2 * r, color);         // Top
@@ -674,6 +728,8 @@ void Adafruit_GFX::drawRoundRect(int16_t x, int16_t y, int16_t w, int16_t h,
   drawCircleHelper(x + w - r - 1, y + h - r - 1, r, 4, color);
   drawCircleHelper(x + r, y + h - r - 1, r, 8, color);
   endWrite();
+  if (held)
+    endPrimitive();
 }
 
 /**************************************************************************/
@@ -692,6 +748,10 @@ void Adafruit_GFX::fillRoundRect(int16_t x, int16_t y, int16_t w, int16_t h,
   int16_t max_radius = ((w < h) ? w : h) / 2; // 1/2 minor axis
   if (r > max_radius)
     r = max_radius;
+  // Degenerate sizes draw outside the box; then each line marks itself
+  bool held = (w > 0) && (h > 0) && (r >= 0);
+  if (held && !startPrimitive(x, y, w, h))
+    return;
   // smarter version
   startWrite();
   writeFillRect(x + r, y, w - 2 * r, h, color);
@@ -699,6 +759,8 @@ void Adafruit_GFX::fillRoundRect(int16_t x, int16_t y, int16_t w, int16_t h,
   fillCircleHelper(x + w - r - 1, y + r, r, 1, h - 2 * r - 1, color);
   fillCircleHelper(x + r, y + r, r, 2, h - 2 * r - 1, color);
   endWrite();
+  if (held)
+    endPrimitive();
 }
 
 /**************************************************************************/
@@ -715,9 +777,14 @@ void Adafruit_GFX::fillRoundRect(int16_t x, int16_t y, int16_t w, int16_t h,
 /**************************************************************************/
 void Adafruit_GFX::drawTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
                                 int16_t x2, int16_t y2, uint16_t color) {
+  if (!startPrimitive(min(min(x0, x1), x2), min(min(y0, y1), y2),
+                      max(max(x0, x1), x2) - min(min(x0, x1), x2) + 1,
+                      max(max(y0, y1), y2) - min(min(y0, y1), y2) + 1))
+    return;
   drawLine(x0, y0, x1, y1, color);
   drawLine(x1, y1, x2, y2, color);
   drawLine(x2, y2, x0, y0, color);
+  endPrimitive();
 }
 
 /**************************************************************************/
@@ -734,6 +801,10 @@ void Adafruit_GFX::drawTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
 /**************************************************************************/
 void Adafruit_GFX::fillTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
                                 int16_t x2, int16_t y2, uint16_t color) {
+  if (!startPrimitive(min(min(x0, x1), x2), min(min(y0, y1), y2),
+                      max(max(x0, x1), x2) - min(min(x0, x1), x2) + 1,
+                      max(max(y0, y1), y2) - min(min(y0, y1), y2) + 1))
+    return;
 
   int16_t a, b, y, last;
 
@@ -764,6 +835,7 @@ void Adafruit_GFX::fillTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
       b = x2;
     writeFastHLine(a, y0, b - a + 1, color);
     endWrite();
+    endPrimitive();
     return;
   }
 
@@ -814,40 +886,79 @@ void Adafruit_GFX::fillTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
     writeFastHLine(a, y, b - a + 1, color);
   }
   endWrite();
+  endPrimitive();
 }
 
 // BITMAP / XBITMAP / GRAYSCALE / RGB BITMAP FUNCTIONS ---------------------
 
 /**************************************************************************/
 /*!
-   @brief      Draw a PROGMEM-resident 1-bit image at the specified (x,y)
-   position, using the specified foreground color (unset bits are transparent).
+   @brief      Draw a 1-bit image (MSB-first rows, each padded to a whole
+   byte) at the specified (x,y) position. All drawBitmap() overloads end up
+   here. Clipping to the display and clip rect is done once up front;
+   subclasses with a native 1-bit framebuffer can override this to write
+   whole bytes instead of calling writePixel() for each pixel.
     @param    x   Top left corner x coordinate
     @param    y   Top left corner y coordinate
     @param    bitmap  byte array with monochrome bitmap
     @param    w   Width of bitmap in pixels
     @param    h   Height of bitmap in pixels
-    @param    color 16-bit 5-6-5 Color to draw with
+    @param    color 16-bit 5-6-5 Color to draw pixels with
+    @param    bg 16-bit 5-6-5 Color to draw background with (ignored if
+              transparent)
+    @param    transparent If true, unset bits are left untouched
+    @param    progmem If true, bitmap is PROGMEM-resident
 */
 /**************************************************************************/
-void Adafruit_GFX::drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[],
-                              int16_t w, int16_t h, uint16_t color) {
+void Adafruit_GFX::blitBitmap(int16_t x, int16_t y, const uint8_t *bitmap,
+                              int16_t w, int16_t h, uint16_t color,
+                              uint16_t bg, bool transparent, bool progmem) {
 
   int16_t byteWidth = (w + 7) / 8; // Bitmap scanline pad = whole byte
-  uint8_t b = 0;
-
+  int16_t xe = min(_width, clip_x2), ye = min(_height, clip_y2);
+  int16_t i0 = (x < clip_x1) ? clip_x1 - x : 0;
+  int16_t j0 = (y < clip_y1) ? clip_y1 - y : 0;
+  int16_t i1 = (x + w > xe) ? xe - x : w;
+  int16_t j1 = (y + h > ye) ? ye - y : h;
+  if ((i0 >= i1) || (j0 >= j1))
+    return; // Entirely off-screen or outside the clip rect
+
+  if (!startPrimitive(x + i0, y + j0, i1 - i0, j1 - j0))
+    return;
   startWrite();
-  for (int16_t j = 0; j < h; j++, y++) {
-    for (int16_t i = 0; i < w; i++) {
-      if (i & 7)
-        b <<= 1;
+  for (int16_t j = j0; j < j1; j++) {
+    const uint8_t *row = &bitmap[j * byteWidth];
+    uint8_t b = 0;
+    for (int16_t i = i0; i < i1; i++) {
+      if ((i == i0) || !(i & 7))
+        b = (progmem ? pgm_read_byte(&row[i / 8]) : row[i / 8]) << (i & 7);
       else
-        b = pgm_read_byte(&bitmap[j * byteWidth + i / 8]);
+        b <<= 1;
       if (b & 0x80)
-        writePixel(x + i, y, color);
+        writePixel(x + i, y + j, color);
+      else if (!transparent)
+        writePixel(x + i, y + j, bg);
     }
   }
   endWrite();
+  endPrimitive();
+}
+
+/**************************************************************************/
+/*!
+   @brief      Draw a PROGMEM-resident 1-bit image at the specified (x,y)
+   position, using the specified foreground color (unset bits are transparent).
+    @param    x   Top left corner x coordinate
+    @param    y   Top left corner y coordinate
+    @param    bitmap  byte array with monochrome bitmap
+    @param    w   Width of bitmap in pixels
+    @param    h   Height of bitmap in pixels
+    @param    color 16-bit 5-6-5 Color to draw with
+*/
+/**************************************************************************/
+void Adafruit_GFX::drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[],
+                              int16_t w, int16_t h, uint16_t color) {
+  blitBitmap(x, y, bitmap, w, h, color, color, true, true);
 }
 
 /**************************************************************************/
@@ -867,21 +978,7 @@ void Adafruit_GFX::drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[],
 void Adafruit_GFX::drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[],
                               int16_t w, int16_t h, uint16_t color,
                               uint16_t bg) {
-
-  int16_t byteWidth = (w + 7) / 8; // Bitmap scanline pad = whole byte
-  uint8_t b = 0;
-
-  startWrite();
-  for (int16_t j = 0; j < h; j++, y++) {
-    for (int16_t i = 0; i < w; i++) {
-      if (i & 7)
-        b <<= 1;
-      else
-        b = pgm_read_byte(&bitmap[j * byteWidth + i / 8]);
-      writePixel(x + i, y, (b & 0x80) ? color : bg);
-    }
-  }
-  endWrite();
+  blitBitmap(x, y, bitmap, w, h, color, bg, false, true);
 }
 
 /**************************************************************************/
@@ -898,22 +995,7 @@ void Adafruit_GFX::drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[],
 /**************************************************************************/
 void Adafruit_GFX::drawBitmap(int16_t x, int16_t y, uint8_t *bitmap, int16_t w,
                               int16_t h, uint16_t color) {
-
-  int16_t byteWidth = (w + 7) / 8; // Bitmap scanline pad = whole byte
-  uint8_t b = 0;
-
-  startWrite();
-  for (int16_t j = 0; j < h; j++, y++) {
-    for (int16_t i = 0; i < w; i++) {
-      if (i & 7)
-        b <<= 1;
-      else
-        b = bitmap[j * byteWidth + i / 8];
-      if (b & 0x80)
-        writePixel(x + i, y, color);
-    }
-  }
-  endWrite();
+  blitBitmap(x, y, bitmap, w, h, color, color, true, false);
 }
 
 /**************************************************************************/
@@ -932,21 +1014,7 @@ void Adafruit_GFX::drawBitmap(int16_t x, int16_t y, uint8_t *bitmap, int16_t w,
 /**************************************************************************/
 void Adafruit_GFX::drawBitmap(int16_t x, int16_t y, uint8_t *bitmap, int16_t w,
                               int16_t h, uint16_t color, uint16_t bg) {
-
-  int16_t byteWidth = (w + 7) / 8; // Bitmap scanline pad = whole byte
-  uint8_t b = 0;
-
-  startWrite();
-  for (int16_t j = 0; j < h; j++, y++) {
-    for (int16_t i = 0; i < w; i++) {
-      if (i & 7)
-        b <<= 1;
-      else
-        b = bitmap[j * byteWidth + i / 8];
-      writePixel(x + i, y, (b & 0x80) ? color : bg);
-    }
-  }
-  endWrite();
+  blitBitmap(x, y, bitmap, w, h, color, bg, false, false);
 }
 
 /**************************************************************************/
@@ -966,6 +1034,8 @@ void Adafruit_GFX::drawBitmap(int16_t x, int16_t y, uint8_t *bitmap, int16_t w,
 /**************************************************************************/
 void Adafruit_GFX::drawXBitmap(int16_t x, int16_t y, const uint8_t bitmap[],
                                int16_t w, int16_t h, uint16_t color) {
+  if (!startPrimitive(x, y, w, h))
+    return;
 
   int16_t byteWidth = (w + 7) / 8; // Bitmap scanline pad = whole byte
   uint8_t b = 0;
@@ -984,6 +1054,7 @@ void Adafruit_GFX::drawXBitmap(int16_t x, int16_t y, const uint8_t bitmap[],
     }
   }
   endWrite();
+  endPrimitive();
 }
 
 /**************************************************************************/
@@ -1001,6 +1072,8 @@ void Adafruit_GFX::drawXBitmap(int16_t x, int16_t y, const uint8_t bitmap[],
 void Adafruit_GFX::drawGrayscaleBitmap(int16_t x, int16_t y,
                                        const uint8_t bitmap[], int16_t w,
                                        int16_t h) {
+  if (!startPrimitive(x, y, w, h))
+    return;
   startWrite();
   for (int16_t j = 0; j < h; j++, y++) {
     for (int16_t i = 0; i < w; i++) {
@@ -1008,6 +1081,7 @@ void Adafruit_GFX::drawGrayscaleBitmap(int16_t x, int16_t y,
     }
   }
   endWrite();
+  endPrimitive();
 }
 
 /**************************************************************************/
@@ -1024,6 +1098,8 @@ void Adafruit_GFX::drawGrayscaleBitmap(int16_t x, int16_t y,
 /**************************************************************************/
 void Adafruit_GFX::drawGrayscaleBitmap(int16_t x, int16_t y, uint8_t *bitmap,
                                        int16_t w, int16_t h) {
+  if (!startPrimitive(x, y, w, h))
+    return;
   startWrite();
   for (int16_t j = 0; j < h; j++, y++) {
     for (int16_t i = 0; i < w; i++) {
@@ -1031,6 +1107,7 @@ void Adafruit_GFX::drawGrayscaleBitmap(int16_t x, int16_t y, uint8_t *bitmap,
     }
   }
   endWrite();
+  endPrimitive();
 }
 
 /**************************************************************************/
@@ -1052,6 +1129,8 @@ void Adafruit_GFX::drawGrayscaleBitmap(int16_t x, int16_t y,
                                        const uint8_t bitmap[],
                                        const uint8_t mask[], int16_t w,
                                        int16_t h) {
+  if (!startPrimitive(x, y, w, h))
+    return;
   int16_t bw = (w + 7) / 8; // Bitmask scanline pad = whole byte
   uint8_t b = 0;
   startWrite();
@@ -1067,6 +1146,7 @@ void Adafruit_GFX::drawGrayscaleBitmap(int16_t x, int16_t y,
     }
   }
   endWrite();
+  endPrimitive();
 }
 
 /**************************************************************************/
@@ -1086,6 +1166,8 @@ void Adafruit_GFX::drawGrayscaleBitmap(int16_t x, int16_t y,
 /**************************************************************************/
 void Adafruit_GFX::drawGrayscaleBitmap(int16_t x, int16_t y, uint8_t *bitmap,
                                        uint8_t *mask, int16_t w, int16_t h) {
+  if (!startPrimitive(x, y, w, h))
+    return;
   int16_t bw = (w + 7) / 8; // Bitmask scanline pad = whole byte
   uint8_t b = 0;
   startWrite();
@@ -1101,6 +1183,7 @@ void Adafruit_GFX::drawGrayscaleBitmap(int16_t x, int16_t y, uint8_t *bitmap,
     }
   }
   endWrite();
+  endPrimitive();
 }
 
 /**************************************************************************/
@@ -1116,6 +1199,8 @@ void Adafruit_GFX::drawGrayscaleBitmap(int16_t x, int16_t y, uint8_t *bitmap,
 /**************************************************************************/
 void Adafruit_GFX::drawRGBBitmap(int16_t x, int16_t y, const uint16_t bitmap[],
                                  int16_t w, int16_t h) {
+  if (!startPrimitive(x, y, w, h))
+    return;
   startWrite();
   for (int16_t j = 0; j < h; j++, y++) {
     for (int16_t i = 0; i < w; i++) {
@@ -1123,6 +1208,7 @@ void Adafruit_GFX::drawRGBBitmap(int16_t x, int16_t y, const uint16_t bitmap[],
     }
   }
   endWrite();
+  endPrimitive();
 }
 
 /**************************************************************************/
@@ -1138,6 +1224,8 @@ void Adafruit_GFX::drawRGBBitmap(int16_t x, int16_t y, const uint16_t bitmap[],
 /**************************************************************************/
 void Adafruit_GFX::drawRGBBitmap(int16_t x, int16_t y, uint16_t *bitmap,
                                  int16_t w, int16_t h) {
+  if (!startPrimitive(x, y, w, h))
+    return;
   startWrite();
   for (int16_t j = 0; j < h; j++, y++) {
     for (int16_t i = 0; i < w; i++) {
@@ -1145,6 +1233,7 @@ void Adafruit_GFX::drawRGBBitmap(int16_t x, int16_t y, uint16_t *bitmap,
     }
   }
   endWrite();
+  endPrimitive();
 }
 
 /**************************************************************************/
@@ -1163,6 +1252,8 @@ void Adafruit_GFX::drawRGBBitmap(int16_t x, int16_t y, uint16_t *bitmap,
 /**************************************************************************/
 void Adafruit_GFX::drawRGBBitmap(int16_t x, int16_t y, const uint16_t bitmap[],
                                  const uint8_t mask[], int16_t w, int16_t h) {
+  if (!startPrimitive(x, y, w, h))
+    return;
   int16_t bw = (w + 7) / 8; // Bitmask scanline pad = whole byte
   uint8_t b = 0;
   startWrite();
@@ -1178,6 +1269,7 @@ void Adafruit_GFX::drawRGBBitmap(int16_t x, int16_t y, const uint16_t bitmap[],
     }
   }
   endWrite();
+  endPrimitive();
 }
 
 /**************************************************************************/
@@ -1196,6 +1288,8 @@ void Adafruit_GFX::drawRGBBitmap(int16_t x, int16_t y, const uint16_t bitmap[],
 /**************************************************************************/
 void Adafruit_GFX::drawRGBBitmap(int16_t x, int16_t y, uint16_t *bitmap,
                                  uint8_t *mask, int16_t w, int16_t h) {
+  if (!startPrimitive(x, y, w, h))
+    return;
   int16_t bw = (w + 7) / 8; // Bitmask scanline pad = whole byte
   uint8_t b = 0;
   startWrite();
@@ -1211,6 +1305,7 @@ void Adafruit_GFX::drawRGBBitmap(int16_t x, int16_t y, uint16_t *bitmap,
     }
   }
   endWrite();
+  endPrimitive();
 }
 
 // TEXT- AND CHARACTER-HANDLING FUNCTIONS ----------------------------------
@@ -1253,10 +1348,8 @@ void Adafruit_GFX::drawChar(int16_t x, int16_t y, unsigned char c,
 
   if (!gfxFont) { // 'Classic' built-in font
 
-    if ((x >= _width) ||              // Clip right
-        (y >= _height) ||             // Clip bottom
-        ((x + 6 * size_x - 1) < 0) || // Clip left
-        ((y + 8 * size_y - 1) < 0))   // Clip top
+    // Whole character off-screen or outside the clip rect?
+    if (!startPrimitive(x, y, 6 * size_x, 8 * size_y))
       return;
 
     if (!_cp437 && (c >= 176))
@@ -1287,6 +1380,7 @@ void Adafruit_GFX::drawChar(int16_t x, int16_t y, unsigned char c,
         writeFillRect(x + 5 * size_x, y, size_x, 8 * size_y, bg);
     }
     endWrite();
+    endPrimitive();
 
   } else { // Custom font
 
@@ -1310,8 +1404,6 @@ void Adafruit_GFX::drawChar(int16_t x, int16_t y, unsigned char c,
       yo16 = yo;
     }
 
-    // Todo: Add character clipping here
-
     // NOTE: THERE IS NO 'BACKGROUND' COLOR OPTION ON CUSTOM FONTS.
     // THIS IS ON PURPOSE AND BY DESIGN.  The background color feature
     // has typically been used with the 'classic' font to overwrite old
@@ -1328,24 +1420,69 @@ void Adafruit_GFX::drawChar(int16_t x, int16_t y, unsigned char c,
     // displays supporting setAddrWindow() and pushColors()), but haven't
     // implemented this yet.
 
+    // Reject the glyph if its box lies entirely off-screen or outside the
+    // clip rect; partially visible glyphs are clipped per pixel/span.
+    if (!startPrimitive(x + xo * size_x, y + yo * size_y, w * size_x,
+                        h * size_y))
+      return;
     startWrite();
-    for (yy = 0; yy < h; yy++) {
-      for (xx = 0; xx < w; xx++) {
-        if (!(bit++ & 7)) {
+    if (gfxFontRLE) {
+      // Run-length encoded glyph (see GFXfontRLE). The nibble stream is
+      // decoded on the fly and each 'on' run is drawn as horizontal spans,
+      // split at scanline ends -- no per-pixel bit tests, no glyph buffer.
+      uint16_t left = (uint16_t)w * h; // Pixels not yet decoded
+      bool hi = true, on = false;
+      xx = yy = 0;
+      while (left) {
+        if (hi)
           bits = pgm_read_byte(&bitmap[bo++]);
+        uint8_t run = hi ? (bits >> 4) : (bits & 0x0F);
+        bool toggle = (run != 15);
+        hi = !hi;
+        if (run > left)
+          run = left; // Don't let a malformed stream run off the glyph
+        left -= run;
+        while (run) {
+          uint8_t span = w - xx;
+          if (span > run)
+            span = run;
+          if (on) {
+            if (size_x == 1 && size_y == 1) {
+              writeFastHLine(x + xo + xx, y + yo + yy, span, color);
+            } else {
+              writeFillRect(x + (xo16 + xx) * size_x, y + (yo16 + yy) * size_y,
+                            span * size_x, size_y, color);
+            }
+          }
+          run -= span;
+          if ((xx += span) == w) {
+            xx = 0;
+            yy++;
+          }
         }
-        if (bits & 0x80) {
-          if (size_x == 1 && size_y == 1) {
-            writePixel(x + xo + xx, y + yo + yy, color);
-          } else {
-            writeFillRect(x + (xo16 + xx) * size_x, y + (yo16 + yy) * size_y,
-                          size_x, size_y, color);
+        if (toggle)
+          on = !on;
+      }
+    } else {
+      for (yy = 0; yy < h; yy++) {
+        for (xx = 0; xx < w; xx++) {
+          if (!(bit++ & 7)) {
+            bits = pgm_read_byte(&bitmap[bo++]);
           }
+          if (bits & 0x80) {
+            if (size_x == 1 && size_y == 1) {
+              writePixel(x + xo + xx, y + yo + yy, color);
+            } else {
+              writeFillRect(x + (xo16 + xx) * size_x,
+                            y + (yo16 + yy) * size_y, size_x, size_y, color);
+            }
+          }
+          bits <<= 1;
         }
-        bits <<= 1;
       }
     }
     endWrite();
+    endPrimitive();
 
   } // End classic vs custom font
 }
@@ -1443,6 +1580,7 @@ void Adafruit_GFX::setRotation(uint8_t x) {
     _height = WIDTH;
     break;
   }
+  resetClipRect(); // Clip coordinates are rotation-relative
 }
 
 /**************************************************************************/
@@ -1464,6 +1602,20 @@ void Adafruit_GFX::setFont(const GFXfont *f) {
     cursor_y -= 6;
   }
   gfxFont = (GFXfont *)f;
+  gfxFontRLE = false;
+}
+
+/**************************************************************************/
+/*!
+    @brief Set a run-length encoded font (as produced by fontconvert -r) to
+           display when print()ing. Metrics, wrapping and getTextBounds()
+           behave exactly as with the equivalent uncompressed font.
+    @param  f  The GFXfontRLE object, if NULL use built in 6x8 font
+*/
+/**************************************************************************/
+void Adafruit_GFX::setFontRLE(const GFXfontRLE *f) {
+  setFont(f ? &f->font : NULL);
+  gfxFontRLE = (f != NULL);
 }
 
 /**************************************************************************/
@@ -1647,125 +1799,752 @@ void Adafruit_GFX::getTextBounds(const __FlashStringHelper *str, int16_t x,
   }
 }
 
+// FNV-1a hash of a string, used to pre-screen GFXtextLayoutCache lookups
+static uint32_t layoutHash(const char *str, size_t len) {
+  uint32_t hash = 2166136261UL;
+  while (len--)
+    hash = (hash ^ (uint8_t)*str++) * 16777619UL;
+  return hash;
+}
+
 /**************************************************************************/
 /*!
-    @brief      Invert the display (ideally using built-in hardware command)
-    @param   i  True if you want to invert, false to make 'normal'
+    @brief  Measure and lay out a string once with the current font, text
+            size and wrap setting, for repeated drawing via drawTextLayout().
+            Line breaks and wrapping match print()ing from cursor column 0.
+    @param  str     The ascii string to lay out
+    @param  layout  Destination; fully overwritten
+    @returns  True on success, false if str is longer than
+              GFX_LAYOUT_MAX_CHARS (layout is then left empty)
 */
 /**************************************************************************/
-void Adafruit_GFX::invertDisplay(bool i) {
-  // Do nothing, must be subclassed if supported by hardware
-  (void)i; // disable -Wunused-parameter warning
+bool Adafruit_GFX::layoutText(const char *str, GFXtextLayout *layout) {
+  size_t len = strlen(str);
+
+  layout->font = gfxFont;
+  layout->hash = layoutHash(str, len);
+  layout->wrapWidth = wrap ? _width : 0;
+  layout->size_x = textsize_x;
+  layout->size_y = textsize_y;
+  layout->count = 0;
+  layout->x1 = layout->y1 = 0;
+  layout->w = layout->h = 0;
+  layout->advance_x = layout->advance_y = 0;
+  if (len > GFX_LAYOUT_MAX_CHARS) {
+    layout->len = 0;
+    return false;
+  }
+  layout->len = len;
+  memcpy(layout->text, str, len);
+
+  int16_t x = 0, y = 0, minx = 0x7FFF, miny = 0x7FFF, maxx = -1, maxy = -1;
+  int16_t tsx = (int16_t)textsize_x, tsy = (int16_t)textsize_y;
+  int16_t wrapWidth = layout->wrapWidth;
+  int16_t yAdvance =
+      gfxFont ? tsy * (uint8_t)pgm_read_byte(&gfxFont->yAdvance) : tsy * 8;
+  uint8_t first = 0, last = 0;
+  if (gfxFont) {
+    first = pgm_read_byte(&gfxFont->first);
+    last = pgm_read_byte(&gfxFont->last);
+  }
+
+  // Same placement rules as write(); glyph metrics are read once here
+  // rather than on every draw.
+  for (size_t i = 0; i < len; i++) {
+    uint8_t c = str[i];
+    if (c == '\n') {
+      x = 0;
+      y += yAdvance;
+      continue;
+    }
+    if (c == '\r')
+      continue;
+    int16_t x1, y1, x2, y2;
+    if (gfxFont) {
+      if ((c < first) || (c > last))
+        continue;
+      GFXglyph *glyph = pgm_read_glyph_ptr(gfxFont, c - first);
+      uint8_t gw = pgm_read_byte(&glyph->width),
+              gh = pgm_read_byte(&glyph->height),
+              xa = pgm_read_byte(&glyph->xAdvance);
+      if (!gw || !gh) { // No bitmap, just advance
+        x += xa * tsx;
+        continue;
+      }
+      int16_t xo = (int8_t)pgm_read_byte(&glyph->xOffset),
+              yo = (int8_t)pgm_read_byte(&glyph->yOffset);
+      if (wrapWidth && ((x + tsx * (xo + gw)) > wrapWidth)) {
+        x = 0;
+        y += yAdvance;
+      }
+      x1 = x + xo * tsx;
+      y1 = y + yo * tsy;
+      x2 = x1 + gw * tsx - 1;
+      y2 = y1 + gh * tsy - 1;
+      layout->glyphs[layout->count].x = x;
+      x += xa * tsx;
+    } else {
+      if (wrapWidth && ((x + tsx * 6) > wrapWidth)) {
+        x = 0;
+        y += yAdvance;
+      }
+      x1 = x;
+      y1 = y;
+      x2 = x + tsx * 6 - 1;
+      y2 = y + tsy * 8 - 1;
+      layout->glyphs[layout->count].x = x;
+      x += tsx * 6;
+    }
+    layout->glyphs[layout->count].y = y;
+    layout->glyphs[layout->count].c = c;
+    layout->count++;
+    if (x1 < minx)
+      minx = x1;
+    if (y1 < miny)
+      miny = y1;
+    if (x2 > maxx)
+      maxx = x2;
+    if (y2 > maxy)
+      maxy = y2;
+  }
+
+  if (maxx >= minx) {
+    layout->x1 = minx;
+    layout->w = maxx - minx + 1;
+  }
+  if (maxy >= miny) {
+    layout->y1 = miny;
+    layout->h = maxy - miny + 1;
+  }
+  layout->advance_x = x;
+  layout->advance_y = y;
+  return true;
 }
 
-/***************************************************************************/
+/**************************************************************************/
+/*!
+    @brief  Look up a string's layout in an LRU cache, laying it out (and
+            evicting the least recently used entry) only on a miss.
+    @param  str    The ascii string to lay out
+    @param  cache  Cache to search and fill
+    @returns  Pointer to the cached layout, valid until it is evicted, or
+              NULL if str is too long or the cache could not be allocated
+*/
+/**************************************************************************/
+const GFXtextLayout *Adafruit_GFX::layoutText(const char *str,
+                                              GFXtextLayoutCache *cache) {
+  GFXtextLayout key;
+  size_t len = strlen(str);
+  if (len > GFX_LAYOUT_MAX_CHARS)
+    return NULL;
+  key.hash = layoutHash(str, len);
+  key.font = gfxFont;
+  key.wrapWidth = wrap ? _width : 0;
+  key.size_x = textsize_x;
+  key.size_y = textsize_y;
+  key.len = len;
+
+  GFXtextLayout *layout = cache->find(&key, str);
+  if (!layout && (layout = cache->reserve()))
+    layoutText(str, layout);
+  return layout;
+}
 
 /**************************************************************************/
 /*!
-   @brief    Create a simple drawn button UI element
+    @brief  Draw a string previously laid out with layoutText(), transparent
+            background. The font selected when it was laid out must still be
+            current; if it isn't, nothing is drawn. Leaves the text cursor
+            after the last character.
+    @param  layout  The layout to draw
+    @param  x       X coordinate of the layout origin
+    @param  y       Y coordinate of the layout origin
+    @param  color   16-bit 5-6-5 Color to draw text with
 */
 /**************************************************************************/
-Adafruit_GFX_Button::Adafruit_GFX_Button(void) { _gfx = 0; }
+void Adafruit_GFX::drawTextLayout(const GFXtextLayout *layout, int16_t x,
+                                  int16_t y, uint16_t color) {
+  drawTextLayout(layout, x, y, color, color);
+}
 
 /**************************************************************************/
 /*!
-   @brief    Initialize button with our desired color/size/settings
-   @param    gfx     Pointer to our display so we can draw to it!
-   @param    x       The X coordinate of the center of the button
-   @param    y       The Y coordinate of the center of the button
-   @param    w       Width of the buttton
-   @param    h       Height of the buttton
-   @param    outline  Color of the outline (16-bit 5-6-5 standard)
-   @param    fill  Color of the button fill (16-bit 5-6-5 standard)
-   @param    textcolor  Color of the button label (16-bit 5-6-5 standard)
-   @param    label  Ascii string of the text inside the button
-   @param    textsize The font magnification of the label text
+    @brief  Draw a string previously laid out with layoutText(). The font
+            selected when it was laid out must still be current; if it
+            isn't, nothing is drawn and the cursor doesn't move. Otherwise
+            leaves the text cursor after the last character.
+    @param  layout  The layout to draw
+    @param  x       X coordinate of the layout origin
+    @param  y       Y coordinate of the layout origin
+    @param  color   16-bit 5-6-5 Color to draw text with
+    @param  bg      16-bit 5-6-5 Color to fill background with (if same as
+                    color, no background)
 */
 /**************************************************************************/
-// Classic initButton() function: pass center & size
-void Adafruit_GFX_Button::initButton(Adafruit_GFX *gfx, int16_t x, int16_t y,
-                                     uint16_t w, uint16_t h, uint16_t outline,
-                                     uint16_t fill, uint16_t textcolor,
-                                     char *label, uint8_t textsize) {
-  // Tweak arguments and pass to the newer initButtonUL() function...
-  initButtonUL(gfx, x - (w / 2), y - (h / 2), w, h, outline, fill, textcolor,
-               label, textsize);
+void Adafruit_GFX::drawTextLayout(const GFXtextLayout *layout, int16_t x,
+                                  int16_t y, uint16_t color, uint16_t bg) {
+  // Glyph positions and codes are only valid for the font they came from
+  if (layout->font != gfxFont)
+    return;
+  for (uint8_t i = 0; i < layout->count; i++) {
+    const GFXlayoutGlyph *g = &layout->glyphs[i];
+    drawChar(x + g->x, y + g->y, g->c, color, bg, layout->size_x,
+             layout->size_y);
+  }
+  cursor_x = x + layout->advance_x;
+  cursor_y = y + layout->advance_y;
 }
 
 /**************************************************************************/
 /*!
-   @brief    Initialize button with our desired color/size/settings
-   @param    gfx     Pointer to our display so we can draw to it!
-   @param    x       The X coordinate of the center of the button
-   @param    y       The Y coordinate of the center of the button
-   @param    w       Width of the buttton
-   @param    h       Height of the buttton
-   @param    outline  Color of the outline (16-bit 5-6-5 standard)
-   @param    fill  Color of the button fill (16-bit 5-6-5 standard)
-   @param    textcolor  Color of the button label (16-bit 5-6-5 standard)
-   @param    label  Ascii string of the text inside the button
-   @param    textsize_x The font magnification in X-axis of the label text
-   @param    textsize_y The font magnification in Y-axis of the label text
+    @brief  The out-of-line part of markDirty(), run when no primitive is
+            holding it off. The rectangle is clipped to the display and clip
+            rect, converted to raw (unrotated) coordinates and merged into
+            the dirty list.
+    @param  x  Left edge, in current rotation coordinates
+    @param  y  Top edge, in current rotation coordinates
+    @param  w  Width in pixels (negative extends to the left)
+    @param  h  Height in pixels (negative extends upward)
 */
 /**************************************************************************/
-// Classic initButton() function: pass center & size
-void Adafruit_GFX_Button::initButton(Adafruit_GFX *gfx, int16_t x, int16_t y,
-                                     uint16_t w, uint16_t h, uint16_t outline,
-                                     uint16_t fill, uint16_t textcolor,
-                                     char *label, uint8_t textsize_x,
-                                     uint8_t textsize_y) {
-  // Tweak arguments and pass to the newer initButtonUL() function...
-  initButtonUL(gfx, x - (w / 2), y - (h / 2), w, h, outline, fill, textcolor,
-               label, textsize_x, textsize_y);
+void Adafruit_GFX::mergeDirty(int16_t x, int16_t y, int16_t w, int16_t h) {
+  // Negative sizes are drawn inconsistently (some primitives span x+w+1..x,
+  // others x+w-1..x), so cover both
+  if (w < 0) {
+    x += w - 1;
+    w = 2 - w;
+  }
+  if (h < 0) {
+    y += h - 1;
+    h = 2 - h;
+  }
+  int16_t xe = min(_width, clip_x2), ye = min(_height, clip_y2);
+  if ((x >= xe) || (y >= ye))
+    return;
+  if (x < clip_x1) { // Clip left/top
+    w -= clip_x1 - x;
+    x = clip_x1;
+  }
+  if (y < clip_y1) {
+    h -= clip_y1 - y;
+    y = clip_y1;
+  }
+  if (w > xe - x) // Clip right/bottom
+    w = xe - x;
+  if (h > ye - y)
+    h = ye - y;
+  if ((w <= 0) || (h <= 0))
+    return;
+
+  GFXrect r;
+  switch (rotation) {
+  case 1:
+    r.x = WIDTH - y - h;
+    r.y = x;
+    r.w = h;
+    r.h = w;
+    break;
+  case 2:
+    r.x = WIDTH - x - w;
+    r.y = HEIGHT - y - h;
+    r.w = w;
+    r.h = h;
+    break;
+  case 3:
+    r.x = y;
+    r.y = HEIGHT - x - w;
+    r.w = h;
+    r.h = w;
+    break;
+  default:
+    r.x = x;
+    r.y = y;
+    r.w = w;
+    r.h = h;
+    break;
+  }
+
+  for (uint8_t i = 0; i < dirtyCount; i++) { // Already covered?
+    const GFXrect *d = &dirtyRects[i];
+    if ((r.x >= d->x) && (r.y >= d->y) && (r.x + r.w <= d->x + d->w) &&
+        (r.y + r.h <= d->y + d->h))
+      return;
+  }
+
+  // Merge with the existing rectangle whose union wastes the least area.
+  // Overlapping or adjacent rects (and near misses, since every separate
+  // rect costs the driver an address-window setup) always merge; otherwise
+  // the new rect gets its own slot while one is free. A merge can make the
+  // result overlap another entry, so repeat until nothing else qualifies.
+  for (;;) {
+    int8_t best = -1;
+    int32_t bestCost = 0x7FFFFFFF;
+    GFXrect u, bestU;
+    for (uint8_t i = 0; i < dirtyCount; i++) {
+      const GFXrect *d = &dirtyRects[i];
+      u.x = min(d->x, r.x);
+      u.y = min(d->y, r.y);
+      u.w = max(d->x + d->w, r.x + r.w) - u.x;
+      u.h = max(d->y + d->h, r.y + r.h) - u.y;
+      int32_t cost = (int32_t)u.w * u.h - (int32_t)d->w * d->h -
+                     (int32_t)r.w * r.h;
+      if (cost < bestCost) {
+        bestCost = cost;
+        best = i;
+        bestU = u;
+      }
+    }
+    if ((best < 0) || ((bestCost > 64) && (dirtyCount < GFX_DIRTY_RECTS)))
+      break;
+    r = bestU; // Absorb the chosen entry and look again
+    dirtyRects[best] = dirtyRects[--dirtyCount];
+  }
+  dirtyRects[dirtyCount++] = r;
 }
 
 /**************************************************************************/
 /*!
-   @brief    Initialize button with our desired color/size/settings, with
-   upper-left coordinates
-   @param    gfx     Pointer to our display so we can draw to it!
-   @param    x1       The X coordinate of the Upper-Left corner of the button
-   @param    y1       The Y coordinate of the Upper-Left corner of the button
-   @param    w       Width of the buttton
-   @param    h       Height of the buttton
-   @param    outline  Color of the outline (16-bit 5-6-5 standard)
-   @param    fill  Color of the button fill (16-bit 5-6-5 standard)
-   @param    textcolor  Color of the button label (16-bit 5-6-5 standard)
-   @param    label  Ascii string of the text inside the button
-   @param    textsize The font magnification of the label text
+    @brief  Forget all dirty regions. Call after flushing them to the panel.
 */
 /**************************************************************************/
-void Adafruit_GFX_Button::initButtonUL(Adafruit_GFX *gfx, int16_t x1,
-                                       int16_t y1, uint16_t w, uint16_t h,
-                                       uint16_t outline, uint16_t fill,
-                                       uint16_t textcolor, char *label,
-                                       uint8_t textsize) {
-  initButtonUL(gfx, x1, y1, w, h, outline, fill, textcolor, label, textsize,
-               textsize);
+void Adafruit_GFX::clearDirty(void) { dirtyCount = 0; }
+
+/**************************************************************************/
+/*!
+    @brief  Get a single rectangle enclosing every dirty region
+    @param  r  Set to the bounds, in raw (unrotated) coordinates
+    @returns  True if anything is dirty, false (r untouched) if not
+*/
+/**************************************************************************/
+bool Adafruit_GFX::getDirtyBounds(GFXrect *r) const {
+  if (!dirtyCount)
+    return false;
+  int16_t x1 = dirtyRects[0].x, y1 = dirtyRects[0].y,
+          x2 = x1 + dirtyRects[0].w, y2 = y1 + dirtyRects[0].h;
+  for (uint8_t i = 1; i < dirtyCount; i++) {
+    const GFXrect *d = &dirtyRects[i];
+    x1 = min(x1, d->x);
+    y1 = min(y1, d->y);
+    x2 = max(x2, (int16_t)(d->x + d->w));
+    y2 = max(y2, (int16_t)(d->y + d->h));
+  }
+  r->x = x1;
+  r->y = y1;
+  r->w = x2 - x1;
+  r->h = y2 - y1;
+  return true;
 }
 
 /**************************************************************************/
 /*!
-   @brief    Initialize button with our desired color/size/settings, with
-   upper-left coordinates
-   @param    gfx     Pointer to our display so we can draw to it!
-   @param    x1       The X coordinate of the Upper-Left corner of the button
-   @param    y1       The Y coordinate of the Upper-Left corner of the button
-   @param    w       Width of the buttton
-   @param    h       Height of the buttton
-   @param    outline  Color of the outline (16-bit 5-6-5 standard)
-   @param    fill  Color of the button fill (16-bit 5-6-5 standard)
-   @param    textcolor  Color of the button label (16-bit 5-6-5 standard)
-   @param    label  Ascii string of the text inside the button
-   @param    textsize_x The font magnification in X-axis of the label text
-   @param    textsize_y The font magnification in Y-axis of the label text
+    @brief  Limit drawing to a rectangle. Primitives entirely outside it are
+            skipped before any pixel work; partly visible ones are clipped
+            per pixel or per span. The rect is intersected with the display
+            and applies to the current rotation only.
+    @param  x  Left edge, in current rotation coordinates
+    @param  y  Top edge, in current rotation coordinates
+    @param  w  Width in pixels (0 or less disables all drawing)
+    @param  h  Height in pixels (0 or less disables all drawing)
 */
 /**************************************************************************/
-void Adafruit_GFX_Button::initButtonUL(Adafruit_GFX *gfx, int16_t x1,
-                                       int16_t y1, uint16_t w, uint16_t h,
-                                       uint16_t outline, uint16_t fill,
-                                       uint16_t textcolor, char *label,
-                                       uint8_t textsize_x, uint8_t textsize_y) {
+void Adafruit_GFX::setClipRect(int16_t x, int16_t y, int16_t w, int16_t h) {
+  int32_t x2 = (int32_t)x + w, y2 = (int32_t)y + h;
+  clip_x1 = max(x, (int16_t)0);
+  clip_y1 = max(y, (int16_t)0);
+  clip_x2 = (x2 > _width) ? _width : x2;
+  clip_y2 = (y2 > _height) ? _height : y2;
+  if ((clip_x1 >= clip_x2) || (clip_y1 >= clip_y2)) // Empty
+    clip_x1 = clip_y1 = clip_x2 = clip_y2 = 0;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Remove the clip rect, allowing drawing anywhere on the display
+*/
+/**************************************************************************/
+void Adafruit_GFX::resetClipRect(void) {
+  clip_x1 = clip_y1 = 0;
+  clip_x2 = clip_y2 = 0x7FFF; // Display bounds are checked separately
+}
+
+/**************************************************************************/
+/*!
+    @brief  Get the area drawing is currently limited to
+    @param  x  Set to the left edge, in current rotation coordinates
+    @param  y  Set to the top edge, in current rotation coordinates
+    @param  w  Set to the width in pixels
+    @param  h  Set to the height in pixels
+*/
+/**************************************************************************/
+void Adafruit_GFX::getClipRect(int16_t *x, int16_t *y, int16_t *w,
+                               int16_t *h) const {
+  *x = clip_x1;
+  *y = clip_y1;
+  *w = min(_width, clip_x2) - clip_x1;
+  *h = min(_height, clip_y2) - clip_y1;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Begin a drawing primitive: reject it if its bounding box misses
+            the display or clip rect, otherwise mark the box dirty and hold
+            off markDirty() for the nested calls it makes. Nested primitives
+            are always accepted (their parent already passed the test).
+            Every true return must be paired with endPrimitive().
+    @param  x  Left edge, in current rotation coordinates
+    @param  y  Top edge, in current rotation coordinates
+    @param  w  Width in pixels (negative extends to the left)
+    @param  h  Height in pixels (negative extends upward)
+    @returns  false if nothing could be drawn and the primitive should return
+*/
+/**************************************************************************/
+bool Adafruit_GFX::startPrimitive(int16_t x, int16_t y, int16_t w,
+                                  int16_t h) {
+  if (dirtyHold) {
+    dirtyHold++;
+    return true;
+  }
+  if (w < 0) { // Same conservative normalization as mergeDirty()
+    x += w - 1;
+    w = 2 - w;
+  }
+  if (h < 0) {
+    y += h - 1;
+    h = 2 - h;
+  }
+  if (!w || !h || (x >= min(_width, clip_x2)) ||
+      (y >= min(_height, clip_y2)) || (x + w <= clip_x1) ||
+      (y + h <= clip_y1))
+    return false;
+  mergeDirty(x, y, w, h);
+  dirtyHold++;
+  return true;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Clip a Bresenham line to the display and clip rect without
+            stepping through the pixels outside it. Takes the state
+            writeLine() sets up (x the major axis, swapped with y if steep,
+            and x0 <= x1) and moves the start to the first step whose pixel
+            is inside and the end to the last, jumping the minor coordinate
+            and error term to the values the loop would have reached there.
+            The pixels drawn are exactly those of the unclipped line that
+            fall inside. After k steps from the start the loop has made
+            m(k) = max(0, ceil((k * dy - err) / dx)) minor steps.
+    @param  steep  true if y is the major axis (coordinates swapped)
+    @param  x0     Major axis start; returns the first step to draw
+    @param  y0     Minor axis start; returns its value at the new x0
+    @param  x1     Major axis end; returns the last step to draw
+    @param  err    Error term at x0; returns its value at the new x0
+    @param  dy     Minor axis distance, >= 0 and <= x1 - x0
+    @param  ystep  Minor axis direction, 1 or -1
+    @returns  false if no pixel of the line is inside
+*/
+/**************************************************************************/
+bool Adafruit_GFX::clipLine(bool steep, int16_t *x0, int16_t *y0, int16_t *x1,
+                            int16_t *err, int16_t dy, int16_t ystep) const {
+  // Inclusive window in (major, minor) coordinates
+  int16_t xa = max(clip_x1, (int16_t)0), xb = min(_width, clip_x2) - 1;
+  int16_t ya = max(clip_y1, (int16_t)0), yb = min(_height, clip_y2) - 1;
+  if (steep) {
+    _swap_int16_t(xa, ya);
+    _swap_int16_t(xb, yb);
+  }
+  int16_t y1 = *y0 + ystep * dy;
+  int16_t ylo = min(*y0, y1), yhi = max(*y0, y1);
+  if ((*x0 >= xa) && (*x1 <= xb) && (ylo >= ya) && (yhi <= yb))
+    return true; // Wholly inside, the usual case
+  if ((*x0 > xb) || (*x1 < xa) || (ylo > yb) || (yhi < ya))
+    return false;
+
+  int32_t dx = *x1 - *x0, e = *err;
+  int32_t k0 = max((int32_t)0, (int32_t)xa - *x0); // Steps from x0 to draw
+  int32_t k1 = min(dx, (int32_t)xb - *x0);
+  if (dy) {
+    // Minor steps m that keep the minor coordinate inside. mhi >= 0, as
+    // y0 itself is not past the far side, and never needs to exceed dy
+    int32_t mlo = (ystep > 0) ? ya - *y0 : *y0 - yb;
+    int32_t mhi = min((int32_t)dy, (ystep > 0) ? yb - *y0 : *y0 - ya);
+    if (mlo > 0) // m(k) >= mlo from this step on
+      k0 = max(k0, ((mlo - 1) * dx + e) / dy + 1);
+    k1 = min(k1, (mhi * dx + e) / dy); // m(k) <= mhi up to this step
+  }
+  if (k0 > k1)
+    return false;
+
+  int32_t m = k0 * dy - e;
+  m = (m > 0) ? (m + dx - 1) / dx : 0;
+  *x1 = *x0 + k1;
+  *x0 += k0;
+  *y0 += ystep * m;
+  *err = e - k0 * dy + m * dx;
+  return true;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Clip a rectangle to the display and clip rect, then map it to
+            raw (rotation 0) buffer coordinates, as the canvases store it.
+    @param  x  Left edge in current rotation coordinates; returns raw left
+    @param  y  Top edge in current rotation coordinates; returns raw top
+    @param  w  Width in pixels (>= 0); returns raw width
+    @param  h  Height in pixels (>= 0); returns raw height
+    @returns  false if nothing of the rectangle is left to draw
+*/
+/**************************************************************************/
+bool Adafruit_GFX::clipRawRect(int16_t *x, int16_t *y, int16_t *w,
+                               int16_t *h) const {
+  int16_t x1 = max(*x, clip_x1), y1 = max(*y, clip_y1);
+  int16_t x2 = min((int32_t)*x + *w, (int32_t)min(_width, clip_x2));
+  int16_t y2 = min((int32_t)*y + *h, (int32_t)min(_height, clip_y2));
+  if ((x1 >= x2) || (y1 >= y2))
+    return false;
+  switch (rotation) {
+  case 0:
+    *x = x1;
+    *y = y1;
+    *w = x2 - x1;
+    *h = y2 - y1;
+    break;
+  case 1:
+    *x = WIDTH - y2;
+    *y = x1;
+    *w = y2 - y1;
+    *h = x2 - x1;
+    break;
+  case 2:
+    *x = WIDTH - x2;
+    *y = HEIGHT - y2;
+    *w = x2 - x1;
+    *h = y2 - y1;
+    break;
+  default:
+    *x = y1;
+    *y = HEIGHT - x2;
+    *w = y2 - y1;
+    *h = x2 - x1;
+    break;
+  }
+  return true;
+}
+
+/**************************************************************************/
+/*!
+    @brief      Invert the display (ideally using built-in hardware command)
+    @param   i  True if you want to invert, false to make 'normal'
+*/
+/**************************************************************************/
+void Adafruit_GFX::invertDisplay(bool i) {
+  // Do nothing, must be subclassed if supported by hardware
+  (void)i; // disable -Wunused-parameter warning
+}
+
+/***************************************************************************/
+
+/**************************************************************************/
+/*!
+   @brief    Create an LRU cache of text layouts. Each entry holds one
+             GFXtextLayout (a few hundred bytes at the default
+             GFX_LAYOUT_MAX_CHARS), allocated here.
+   @param    n  Number of layouts to keep
+*/
+/**************************************************************************/
+GFXtextLayoutCache::GFXtextLayoutCache(uint8_t n) : n(n), tick(0) {
+  if ((entries = (GFXtextLayout *)malloc(n * sizeof(GFXtextLayout)))) {
+    clear();
+  }
+}
+
+/**************************************************************************/
+/*!
+   @brief    Delete the cache, free memory
+*/
+/**************************************************************************/
+GFXtextLayoutCache::~GFXtextLayoutCache(void) {
+  if (entries)
+    free(entries);
+}
+
+/**************************************************************************/
+/*!
+   @brief    Forget all cached layouts, e.g. after changing font glyph data
+*/
+/**************************************************************************/
+void GFXtextLayoutCache::clear(void) {
+  if (entries) {
+    for (uint8_t i = 0; i < n; i++)
+      entries[i].stamp = 0; // 0 = unused slot
+  }
+}
+
+/**************************************************************************/
+/*!
+   @brief    Find a cached layout with the same font, size, wrap width and
+             text, and mark it most recently used
+   @param    key  Layout whose font, hash, wrapWidth, size_x, size_y and len
+                  are filled in
+   @param    str  The text itself, compared against the cached copy
+   @returns  Matching entry, or NULL on a miss
+*/
+/**************************************************************************/
+GFXtextLayout *GFXtextLayoutCache::find(const GFXtextLayout *key,
+                                        const char *str) {
+  if (!entries)
+    return NULL;
+  for (uint8_t i = 0; i < n; i++) {
+    GFXtextLayout *e = &entries[i];
+    if (e->stamp && (e->hash == key->hash) && (e->len == key->len) &&
+        (e->font == key->font) && (e->size_x == key->size_x) &&
+        (e->size_y == key->size_y) && (e->wrapWidth == key->wrapWidth) &&
+        !memcmp(e->text, str, key->len)) {
+      if (!++tick)
+        tick = 1;
+      e->stamp = tick;
+      return e;
+    }
+  }
+  return NULL;
+}
+
+/**************************************************************************/
+/*!
+   @brief    Claim an unused or the least recently used entry, marked most
+             recently used, for the caller to fill with layoutText()
+   @returns  Entry to overwrite, or NULL if allocation failed
+*/
+/**************************************************************************/
+GFXtextLayout *GFXtextLayoutCache::reserve(void) {
+  if (!entries)
+    return NULL;
+  GFXtextLayout *victim = &entries[0];
+  uint16_t oldest = 0;
+  for (uint8_t i = 0; i < n; i++) {
+    GFXtextLayout *e = &entries[i];
+    if (!e->stamp) { // Unused, take it
+      victim = e;
+      break;
+    }
+    uint16_t age = tick - e->stamp; // Wraparound-safe
+    if (age >= oldest) {
+      oldest = age;
+      victim = e;
+    }
+  }
+  if (!++tick)
+    tick = 1;
+  victim->stamp = tick;
+  return victim;
+}
+
+/***************************************************************************/
+
+/**************************************************************************/
+/*!
+   @brief    Create a simple drawn button UI element
+*/
+/**************************************************************************/
+Adafruit_GFX_Button::Adafruit_GFX_Button(void) { _gfx = 0; }
+
+/**************************************************************************/
+/*!
+   @brief    Initialize button with our desired color/size/settings
+   @param    gfx     Pointer to our display so we can draw to it!
+   @param    x       The X coordinate of the center of the button
+   @param    y       The Y coordinate of the center of the button
+   @param    w       Width of the buttton
+   @param    h       Height of the buttton
+   @param    outline  Color of the outline (16-bit 5-6-5 standard)
+   @param    fill  Color of the button fill (16-bit 5-6-5 standard)
+   @param    textcolor  Color of the button label (16-bit 5-6-5 standard)
+   @param    label  Ascii string of the text inside the button
+   @param    textsize The font magnification of the label text
+*/
+/**************************************************************************/
+// Classic initButton() function: pass center & size
+void Adafruit_GFX_Button::initButton(Adafruit_GFX *gfx, int16_t x, int16_t y,
+                                     uint16_t w, uint16_t h, uint16_t outline,
+                                     uint16_t fill, uint16_t textcolor,
+                                     char *label, uint8_t textsize) {
+  // Tweak arguments and pass to the newer initButtonUL() function...
+  initButtonUL(gfx, x - (w / 2), y - (h / 2), w, h, outline, fill, textcolor,
+               label, textsize);
+}
+
+/**************************************************************************/
+/*!
+   @brief    Initialize button with our desired color/size/settings
+   @param    gfx     Pointer to our display so we can draw to it!
+   @param    x       The X coordinate of the center of the button
+   @param    y       The Y coordinate of the center of the button
+   @param    w       Width of the buttton
+   @param    h       Height of the buttton
+   @param    outline  Color of the outline (16-bit 5-6-5 standard)
+   @param    fill  Color of the button fill (16-bit 5-6-5 standard)
+   @param    textcolor  Color of the button label (16-bit 5-6-5 standard)
+   @param    label  Ascii string of the text inside the button
+   @param    textsize_x The font magnification in X-axis of the label text
+   @param    textsize_y The font magnification in Y-axis of the label text
+*/
+/**************************************************************************/
+// Classic initButton() function: pass center & size
+void Adafruit_GFX_Button::initButton(Adafruit_GFX *gfx, int16_t x, int16_t y,
+                                     uint16_t w, uint16_t h, uint16_t outline,
+                                     uint16_t fill, uint16_t textcolor,
+                                     char *label, uint8_t textsize_x,
+                                     uint8_t textsize_y) {
+  // Tweak arguments and pass to the newer initButtonUL() function...
+  initButtonUL(gfx, x - (w / 2), y - (h / 2), w, h, outline, fill, textcolor,
+               label, textsize_x, textsize_y);
+}
+
+/**************************************************************************/
+/*!
+   @brief    Initialize button with our desired color/size/settings, with
+   upper-left coordinates
+   @param    gfx     Pointer to our display so we can draw to it!
+   @param    x1       The X coordinate of the Upper-Left corner of the button
+   @param    y1       The Y coordinate of the Upper-Left corner of the button
+   @param    w       Width of the buttton
+   @param    h       Height of the buttton
+   @param    outline  Color of the outline (16-bit 5-6-5 standard)
+   @param    fill  Color of the button fill (16-bit 5-6-5 standard)
+   @param    textcolor  Color of the button label (16-bit 5-6-5 standard)
+   @param    label  Ascii string of the text inside the button
+   @param    textsize The font magnification of the label text
+*/
+/**************************************************************************/
+void Adafruit_GFX_Button::initButtonUL(Adafruit_GFX *gfx, int16_t x1,
+                                       int16_t y1, uint16_t w, uint16_t h,
+                                       uint16_t outline, uint16_t fill,
+                                       uint16_t textcolor, char *label,
+                                       uint8_t textsize) {
+  initButtonUL(gfx, x1, y1, w, h, outline, fill, textcolor, label, textsize,
+               textsize);
+}
+
+/**************************************************************************/
+/*!
+   @brief    Initialize button with our desired color/size/settings, with
+   upper-left coordinates
+   @param    gfx     Pointer to our display so we can draw to it!
+   @param    x1       The X coordinate of the Upper-Left corner of the button
+   @param    y1       The Y coordinate of the Upper-Left corner of the button
+   @param    w       Width of the buttton
+   @param    h       Height of the buttton
+   @param    outline  Color of the outline (16-bit 5-6-5 standard)
+   @param    fill  Color of the button fill (16-bit 5-6-5 standard)
+   @param    textcolor  Color of the button label (16-bit 5-6-5 standard)
+   @param    label  Ascii string of the text inside the button
+   @param    textsize_x The font magnification in X-axis of the label text
+   @param    textsize_y The font magnification in Y-axis of the label text
+*/
+/**************************************************************************/
+void Adafruit_GFX_Button::initButtonUL(Adafruit_GFX *gfx, int16_t x1,
+                                       int16_t y1, uint16_t w, uint16_t h,
+                                       uint16_t outline, uint16_t fill,
+                                       uint16_t textcolor, char *label,
+                                       uint8_t textsize_x, uint8_t textsize_y) {
   _x1 = x1;
   _y1 = y1;
   _w = w;
@@ -1828,62 +2607,438 @@ bool Adafruit_GFX_Button::contains(int16_t x, int16_t y) {
 
 /**************************************************************************/
 /*!
-   @brief    Query whether the button was pressed since we last checked state
-   @returns  True if was not-pressed before, now is.
+   @brief    Query whether the button was pressed since we last checked state
+   @returns  True if was not-pressed before, now is.
+*/
+/**************************************************************************/
+bool Adafruit_GFX_Button::justPressed() { return (currstate && !laststate); }
+
+/**************************************************************************/
+/*!
+   @brief    Query whether the button was released since we last checked state
+   @returns  True if was pressed before, now is not.
+*/
+/**************************************************************************/
+bool Adafruit_GFX_Button::justReleased() { return (!currstate && laststate); }
+
+// -------------------------------------------------------------------------
+
+// GFXcanvas1, GFXcanvas8 and GFXcanvas16 (currently a WIP, don't get too
+// comfy with the implementation) provide 1-, 8- and 16-bit offscreen
+// canvases, the address of which can be passed to drawBitmap() or
+// pushColors() (the latter appears only in a couple of GFX-subclassed TFT
+// libraries at this time).  This is here mostly to help with the recently-
+// added proportionally-spaced fonts; adds a way to refresh a section of the
+// screen without a massive flickering clear-and-redraw...but maybe you'll
+// find other uses too.  VERY RAM-intensive, since the buffer is in MCU
+// memory and not the display driver...GXFcanvas1 might be minimally useful
+// on an Uno-class board, but this and the others are much more likely to
+// require at least a Mega or various recent ARM-type boards (recommended,
+// as the text+bitmap draw can be pokey).  GFXcanvas1 requires 1 bit per
+// pixel (rounded up to nearest byte per scanline), GFXcanvas8 is 1 byte
+// per pixel (no scanline pad), and GFXcanvas16 uses 2 bytes per pixel (no
+// scanline pad).
+// NOT EXTENSIVELY TESTED YET.  MAY CONTAIN WORST BUGS KNOWN TO HUMANKIND.
+
+#ifdef __AVR__
+// Bitmask tables of 0x80>>X and ~(0x80>>X), because X>>Y is slow on AVR
+const uint8_t PROGMEM GFXcanvas1::GFXsetBit[] = {0x80, 0x40, 0x20, 0x10,
+                                                 0x08, 0x04, 0x02, 0x01};
+const uint8_t PROGMEM GFXcanvas1::GFXclrBit[] = {0x7F, 0xBF, 0xDF, 0xEF,
+                                                 0xF7, 0xFB, 0xFD, 0xFE};
+#endif
+
+/**************************************************************************/
+/*!
+   @brief    Instatiate a GFX 1-bit canvas context for graphics
+   @param    w   Display width, in pixels
+   @param    h   Display height, in pixels
+   @param    allocate_buffer If true, a buffer is allocated with malloc. If
+   false, the subclass must initialize the buffer before any drawing operation,
+   and free it in the destructor. If false (the default), the buffer is
+   allocated and freed by the library.
+*/
+/**************************************************************************/
+GFXcanvas1::GFXcanvas1(uint16_t w, uint16_t h, bool allocate_buffer)
+    : Adafruit_GFX(w, h), buffer_owned(allocate_buffer) {
+  if (allocate_buffer) {
+    uint32_t bytes = ((w + 7) / 8) * h;
+    if ((buffer = (uint8_t *)malloc(bytes))) {
+      memset(buffer, 0, bytes);
+    }
+  } else {
+    buffer = nullptr;
+  }
+}
+
+/**************************************************************************/
+/*!
+   @brief    Delete the canvas, free memory
+*/
+/**************************************************************************/
+GFXcanvas1::~GFXcanvas1(void) {
+  if (buffer && buffer_owned)
+    free(buffer);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Draw a pixel to the canvas framebuffer
+    @param  x     x coordinate
+    @param  y     y coordinate
+    @param  color Binary (on or off) color to fill with
+*/
+/**************************************************************************/
+void GFXcanvas1::drawPixel(int16_t x, int16_t y, uint16_t color) {
+  markDirty(x, y, 1, 1);
+  if (buffer) {
+    if ((x < 0) || (y < 0) || (x >= _width) || (y >= _height) ||
+        clipped(x, y))
+      return;
+
+    int16_t t;
+    switch (rotation) {
+    case 1:
+      t = x;
+      x = WIDTH - 1 - y;
+      y = t;
+      break;
+    case 2:
+      x = WIDTH - 1 - x;
+      y = HEIGHT - 1 - y;
+      break;
+    case 3:
+      t = x;
+      x = y;
+      y = HEIGHT - 1 - t;
+      break;
+    }
+
+    uint8_t *ptr = &buffer[(x / 8) + y * ((WIDTH + 7) / 8)];
+#ifdef __AVR__
+    if (color)
+      *ptr |= pgm_read_byte(&GFXsetBit[x & 7]);
+    else
+      *ptr &= pgm_read_byte(&GFXclrBit[x & 7]);
+#else
+    if (color)
+      *ptr |= 0x80 >> (x & 7);
+    else
+      *ptr &= ~(0x80 >> (x & 7));
+#endif
+  }
+}
+
+/**********************************************************************/
+/*!
+        @brief    Get the pixel color value at a given coordinate
+        @param    x   x coordinate
+        @param    y   y coordinate
+        @returns  The desired pixel's binary color value, either 0x1 (on) or 0x0
+   (off)
+*/
+/**********************************************************************/
+bool GFXcanvas1::getPixel(int16_t x, int16_t y) const {
+  int16_t t;
+  switch (rotation) {
+  case 1:
+    t = x;
+    x = WIDTH - 1 - y;
+    y = t;
+    break;
+  case 2:
+    x = WIDTH - 1 - x;
+    y = HEIGHT - 1 - y;
+    break;
+  case 3:
+    t = x;
+    x = y;
+    y = HEIGHT - 1 - t;
+    break;
+  }
+  return getRawPixel(x, y);
+}
+
+/**********************************************************************/
+/*!
+        @brief    Get the pixel color value at a given, unrotated coordinate.
+              This method is intended for hardware drivers to get pixel value
+              in physical coordinates.
+        @param    x   x coordinate
+        @param    y   y coordinate
+        @returns  The desired pixel's binary color value, either 0x1 (on) or 0x0
+   (off)
+*/
+/**********************************************************************/
+bool GFXcanvas1::getRawPixel(int16_t x, int16_t y) const {
+  if ((x < 0) || (y < 0) || (x >= WIDTH) || (y >= HEIGHT))
+    return 0;
+  if (buffer) {
+    uint8_t *ptr = &buffer[(x / 8) + y * ((WIDTH + 7) / 8)];
+
+#ifdef __AVR__
+    return ((*ptr) & pgm_read_byte(&GFXsetBit[x & 7])) != 0;
+#else
+    return ((*ptr) & (0x80 >> (x & 7))) != 0;
+#endif
+  }
+  return 0;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Fill the framebuffer completely with one color
+    @param  color Binary (on or off) color to fill with
+*/
+/**************************************************************************/
+void GFXcanvas1::fillScreen(uint16_t color) {
+  if (clipActive()) { // Only the clip rect may change
+    fillRect(0, 0, _width, _height, color);
+    return;
+  }
+  markDirty(0, 0, _width, _height);
+  if (buffer) {
+    uint32_t bytes = ((WIDTH + 7) / 8) * HEIGHT;
+    memset(buffer, color ? 0xFF : 0x00, bytes);
+  }
+}
+
+/**************************************************************************/
+/*!
+   @brief  Speed optimized vertical line drawing
+   @param  x      Line horizontal start point
+   @param  y      Line vertical start point
+   @param  h      Length of vertical line to be drawn, including first point
+   @param  color  Color to fill with
+*/
+/**************************************************************************/
+void GFXcanvas1::drawFastVLine(int16_t x, int16_t y, int16_t h,
+                               uint16_t color) {
+
+  markDirty(x, y, 1, h);
+  if (h < 0) { // Convert negative heights to positive equivalent
+    h *= -1;
+    y -= h - 1;
+    if (y < 0) {
+      h += y;
+      y = 0;
+    }
+  }
+
+  // Edge rejection (no-draw if totally off canvas or clip rect)
+  int16_t ye = min(height(), clip_y2);
+  if ((x < clip_x1) || (x >= min(width(), clip_x2)) || (y >= ye) ||
+      ((y + h - 1) < clip_y1)) {
+    return;
+  }
+
+  if (y < clip_y1) { // Clip top
+    h -= clip_y1 - y;
+    y = clip_y1;
+  }
+  if (y + h > ye) { // Clip bottom
+    h = ye - y;
+  }
+
+  if (getRotation() == 0) {
+    drawFastRawVLine(x, y, h, color);
+  } else if (getRotation() == 1) {
+    int16_t t = x;
+    x = WIDTH - 1 - y;
+    y = t;
+    x -= h - 1;
+    drawFastRawHLine(x, y, h, color);
+  } else if (getRotation() == 2) {
+    x = WIDTH - 1 - x;
+    y = HEIGHT - 1 - y;
+
+    y -= h - 1;
+    drawFastRawVLine(x, y, h, color);
+  } else if (getRotation() == 3) {
+    int16_t t = x;
+    x = y;
+    y = HEIGHT - 1 - t;
+    drawFastRawHLine(x, y, h, color);
+  }
+}
+
+/**************************************************************************/
+/*!
+   @brief  Speed optimized horizontal line drawing
+   @param  x      Line horizontal start point
+   @param  y      Line vertical start point
+   @param  w      Length of horizontal line to be drawn, including first point
+   @param  color  Color to fill with
+*/
+/**************************************************************************/
+void GFXcanvas1::drawFastHLine(int16_t x, int16_t y, int16_t w,
+                               uint16_t color) {
+  markDirty(x, y, w, 1);
+  if (w < 0) { // Convert negative widths to positive equivalent
+    w *= -1;
+    x -= w - 1;
+    if (x < 0) {
+      w += x;
+      x = 0;
+    }
+  }
+
+  // Edge rejection (no-draw if totally off canvas or clip rect)
+  int16_t xe = min(width(), clip_x2);
+  if ((y < clip_y1) || (y >= min(height(), clip_y2)) || (x >= xe) ||
+      ((x + w - 1) < clip_x1)) {
+    return;
+  }
+
+  if (x < clip_x1) { // Clip left
+    w -= clip_x1 - x;
+    x = clip_x1;
+  }
+  if (x + w >= xe) { // Clip right
+    w = xe - x;
+  }
+
+  if (getRotation() == 0) {
+    drawFastRawHLine(x, y, w, color);
+  } else if (getRotation() == 1) {
+    int16_t t = x;
+    x = WIDTH - 1 - y;
+    y = t;
+    drawFastRawVLine(x, y, w, color);
+  } else if (getRotation() == 2) {
+    x = WIDTH - 1 - x;
+    y = HEIGHT - 1 - y;
+
+    x -= w - 1;
+    drawFastRawHLine(x, y, w, color);
+  } else if (getRotation() == 3) {
+    int16_t t = x;
+    x = y;
+    y = HEIGHT - 1 - t;
+    y -= w - 1;
+    drawFastRawVLine(x, y, w, color);
+  }
+}
+
+/**************************************************************************/
+/*!
+   @brief    Speed optimized vertical line drawing into the raw canvas buffer
+   @param    x   Line horizontal start point
+   @param    y   Line vertical start point
+   @param    h   length of vertical line to be drawn, including first point
+   @param    color   Binary (on or off) color to fill with
+*/
+/**************************************************************************/
+void GFXcanvas1::drawFastRawVLine(int16_t x, int16_t y, int16_t h,
+                                  uint16_t color) {
+  // x & y already in raw (rotation 0) coordinates, no need to transform.
+  int16_t row_bytes = ((WIDTH + 7) / 8);
+  uint8_t *ptr = &buffer[(x / 8) + y * row_bytes];
+
+  if (color > 0) {
+#ifdef __AVR__
+    uint8_t bit_mask = pgm_read_byte(&GFXsetBit[x & 7]);
+#else
+    uint8_t bit_mask = (0x80 >> (x & 7));
+#endif
+    for (int16_t i = 0; i < h; i++) {
+      *ptr |= bit_mask;
+      ptr += row_bytes;
+    }
+  } else {
+#ifdef __AVR__
+    uint8_t bit_mask = pgm_read_byte(&GFXclrBit[x & 7]);
+#else
+    uint8_t bit_mask = ~(0x80 >> (x & 7));
+#endif
+    for (int16_t i = 0; i < h; i++) {
+      *ptr &= bit_mask;
+      ptr += row_bytes;
+    }
+  }
+}
+
+/**************************************************************************/
+/*!
+   @brief    Speed optimized horizontal line drawing into the raw canvas buffer
+   @param    x   Line horizontal start point
+   @param    y   Line vertical start point
+   @param    w   length of horizontal line to be drawn, including first point
+   @param    color   Binary (on or off) color to fill with
 */
 /**************************************************************************/
-bool Adafruit_GFX_Button::justPressed() { return (currstate && !laststate); }
+void GFXcanvas1::drawFastRawHLine(int16_t x, int16_t y, int16_t w,
+                                  uint16_t color) {
+  // x & y already in raw (rotation 0) coordinates, no need to transform.
+  int16_t rowBytes = ((WIDTH + 7) / 8);
+  uint8_t *ptr = &buffer[(x / 8) + y * rowBytes];
+  size_t remainingWidthBits = w;
 
-/**************************************************************************/
-/*!
-   @brief    Query whether the button was released since we last checked state
-   @returns  True if was pressed before, now is not.
-*/
-/**************************************************************************/
-bool Adafruit_GFX_Button::justReleased() { return (!currstate && laststate); }
+  // check to see if first byte needs to be partially filled
+  if ((x & 7) > 0) {
+    // create bit mask for first byte
+    uint8_t startByteBitMask = 0x00;
+    for (int8_t i = (x & 7); ((i < 8) && (remainingWidthBits > 0)); i++) {
+#ifdef __AVR__
+      startByteBitMask |= pgm_read_byte(&GFXsetBit[i]);
+#else
+      startByteBitMask |= (0x80 >> i);
+#endif
+      remainingWidthBits--;
+    }
+    if (color > 0) {
+      *ptr |= startByteBitMask;
+    } else {
+      *ptr &= ~startByteBitMask;
+    }
 
-// -------------------------------------------------------------------------
+    ptr++;
+  }
 
-// GFXcanvas1, GFXcanvas8 and GFXcanvas16 (currently a WIP, don't get too
-// comfy with the implementation) provide 1-, 8- and 16-bit offscreen
-// canvases, the address of which can be passed to drawBitmap() or
-// pushColors() (the latter appears only in a couple of GFX-subclassed TFT
-// libraries at this time).  This is here mostly to help with the recently-
-// added proportionally-spaced fonts; adds a way to refresh a section of the
-// screen without a massive flickering clear-and-redraw...but maybe you'll
-// find other uses too.  VERY RAM-intensive, since the buffer is in MCU
-// memory and not the display driver...GXFcanvas1 might be minimally useful
-// on an Uno-class board, but this and the others are much more likely to
-// require at least a Mega or various recent ARM-type boards (recommended,
-// as the text+bitmap draw can be pokey).  GFXcanvas1 requires 1 bit per
-// pixel (rounded up to nearest byte per scanline), GFXcanvas8 is 1 byte
-// per pixel (no scanline pad), and GFXcanvas16 uses 2 bytes per pixel (no
-// scanline pad).
-// NOT EXTENSIVELY TESTED YET.  MAY CONTAIN WORST BUGS KNOWN TO HUMANKIND.
+  // do the next remainingWidthBits bits
+  if (remainingWidthBits > 0) {
+    size_t remainingWholeBytes = remainingWidthBits / 8;
+    size_t lastByteBits = remainingWidthBits % 8;
+    uint8_t wholeByteColor = color > 0 ? 0xFF : 0x00;
+
+    memset(ptr, wholeByteColor, remainingWholeBytes);
 
+    if (lastByteBits > 0) {
+      uint8_t lastByteBitMask = 0x00;
+      for (size_t i = 0; i < lastByteBits; i++) {
 #ifdef __AVR__
-// Bitmask tables of 0x80>>X and ~(0x80>>X), because X>>Y is slow on AVR
-const uint8_t PROGMEM GFXcanvas1::GFXsetBit[] = {0x80, 0x40, 0x20, 0x10,
-                                                 0x08, 0x04, 0x02, 0x01};
-const uint8_t PROGMEM GFXcanvas1::GFXclrBit[] = {0x7F, 0xBF, 0xDF, 0xEF,
-                                                 0xF7, 0xFB, 0xFD, 0xFE};
+        lastByteBitMask |= pgm_read_byte(&GFXsetBit[i]);
+#else
+        lastByteBitMask |= (0x80 >> i);
 #endif
+      }
+      ptr += remainingWholeBytes;
+
+      if (color > 0) {
+        *ptr |= lastByteBitMask;
+      } else {
+        *ptr &= ~lastByteBitMask;
+      }
+    }
+  }
+}
 
 /**************************************************************************/
 /*!
-   @brief    Instatiate a GFX 1-bit canvas context for graphics
-   @param    w   Display width, in pixels
-   @param    h   Display height, in pixels
+   @brief    Instatiate a GFX 1-bit page-layout canvas context for graphics
+   @param    w   Canvas width, in pixels
+   @param    h   Canvas height, in pixels (rounded up to a multiple of 8 for
+                 storage)
    @param    allocate_buffer If true, a buffer is allocated with malloc. If
    false, the subclass must initialize the buffer before any drawing operation,
    and free it in the destructor. If false (the default), the buffer is
    allocated and freed by the library.
 */
 /**************************************************************************/
-GFXcanvas1::GFXcanvas1(uint16_t w, uint16_t h, bool allocate_buffer)
+GFXcanvas1V::GFXcanvas1V(uint16_t w, uint16_t h, bool allocate_buffer)
     : Adafruit_GFX(w, h), buffer_owned(allocate_buffer) {
   if (allocate_buffer) {
-    uint32_t bytes = ((w + 7) / 8) * h;
+    uint32_t bytes = w * ((h + 7) / 8);
     if ((buffer = (uint8_t *)malloc(bytes))) {
       memset(buffer, 0, bytes);
     }
@@ -1897,7 +3052,7 @@ GFXcanvas1::GFXcanvas1(uint16_t w, uint16_t h, bool allocate_buffer)
    @brief    Delete the canvas, free memory
 */
 /**************************************************************************/
-GFXcanvas1::~GFXcanvas1(void) {
+GFXcanvas1V::~GFXcanvas1V(void) {
   if (buffer && buffer_owned)
     free(buffer);
 }
@@ -1910,9 +3065,11 @@ GFXcanvas1::~GFXcanvas1(void) {
     @param  color Binary (on or off) color to fill with
 */
 /**************************************************************************/
-void GFXcanvas1::drawPixel(int16_t x, int16_t y, uint16_t color) {
+void GFXcanvas1V::drawPixel(int16_t x, int16_t y, uint16_t color) {
+  markDirty(x, y, 1, 1);
   if (buffer) {
-    if ((x < 0) || (y < 0) || (x >= _width) || (y >= _height))
+    if ((x < 0) || (y < 0) || (x >= _width) || (y >= _height) ||
+        clipped(x, y))
       return;
 
     int16_t t;
@@ -1933,18 +3090,11 @@ void GFXcanvas1::drawPixel(int16_t x, int16_t y, uint16_t color) {
       break;
     }
 
-    uint8_t *ptr = &buffer[(x / 8) + y * ((WIDTH + 7) / 8)];
-#ifdef __AVR__
-    if (color)
-      *ptr |= pgm_read_byte(&GFXsetBit[x & 7]);
-    else
-      *ptr &= pgm_read_byte(&GFXclrBit[x & 7]);
-#else
+    uint8_t *ptr = &buffer[x + (y / 8) * WIDTH];
     if (color)
-      *ptr |= 0x80 >> (x & 7);
+      *ptr |= 1 << (y & 7);
     else
-      *ptr &= ~(0x80 >> (x & 7));
-#endif
+      *ptr &= ~(1 << (y & 7));
   }
 }
 
@@ -1957,7 +3107,7 @@ void GFXcanvas1::drawPixel(int16_t x, int16_t y, uint16_t color) {
    (off)
 */
 /**********************************************************************/
-bool GFXcanvas1::getPixel(int16_t x, int16_t y) const {
+bool GFXcanvas1V::getPixel(int16_t x, int16_t y) const {
   int16_t t;
   switch (rotation) {
   case 1:
@@ -1989,17 +3139,11 @@ bool GFXcanvas1::getPixel(int16_t x, int16_t y) const {
    (off)
 */
 /**********************************************************************/
-bool GFXcanvas1::getRawPixel(int16_t x, int16_t y) const {
+bool GFXcanvas1V::getRawPixel(int16_t x, int16_t y) const {
   if ((x < 0) || (y < 0) || (x >= WIDTH) || (y >= HEIGHT))
     return 0;
   if (buffer) {
-    uint8_t *ptr = &buffer[(x / 8) + y * ((WIDTH + 7) / 8)];
-
-#ifdef __AVR__
-    return ((*ptr) & pgm_read_byte(&GFXsetBit[x & 7])) != 0;
-#else
-    return ((*ptr) & (0x80 >> (x & 7))) != 0;
-#endif
+    return (buffer[x + (y / 8) * WIDTH] >> (y & 7)) & 1;
   }
   return 0;
 }
@@ -2010,9 +3154,14 @@ bool GFXcanvas1::getRawPixel(int16_t x, int16_t y) const {
     @param  color Binary (on or off) color to fill with
 */
 /**************************************************************************/
-void GFXcanvas1::fillScreen(uint16_t color) {
+void GFXcanvas1V::fillScreen(uint16_t color) {
+  if (clipActive()) { // Only the clip rect may change
+    fillRect(0, 0, _width, _height, color);
+    return;
+  }
+  markDirty(0, 0, _width, _height);
   if (buffer) {
-    uint32_t bytes = ((WIDTH + 7) / 8) * HEIGHT;
+    uint32_t bytes = WIDTH * ((HEIGHT + 7) / 8);
     memset(buffer, color ? 0xFF : 0x00, bytes);
   }
 }
@@ -2026,9 +3175,10 @@ void GFXcanvas1::fillScreen(uint16_t color) {
    @param  color  Color to fill with
 */
 /**************************************************************************/
-void GFXcanvas1::drawFastVLine(int16_t x, int16_t y, int16_t h,
-                               uint16_t color) {
+void GFXcanvas1V::drawFastVLine(int16_t x, int16_t y, int16_t h,
+                                uint16_t color) {
 
+  markDirty(x, y, 1, h);
   if (h < 0) { // Convert negative heights to positive equivalent
     h *= -1;
     y -= h - 1;
@@ -2038,17 +3188,19 @@ void GFXcanvas1::drawFastVLine(int16_t x, int16_t y, int16_t h,
     }
   }
 
-  // Edge rejection (no-draw if totally off canvas)
-  if ((x < 0) || (x >= width()) || (y >= height()) || ((y + h - 1) < 0)) {
+  // Edge rejection (no-draw if totally off canvas or clip rect)
+  int16_t ye = min(height(), clip_y2);
+  if ((x < clip_x1) || (x >= min(width(), clip_x2)) || (y >= ye) ||
+      ((y + h - 1) < clip_y1)) {
     return;
   }
 
-  if (y < 0) { // Clip top
-    h += y;
-    y = 0;
+  if (y < clip_y1) { // Clip top
+    h -= clip_y1 - y;
+    y = clip_y1;
   }
-  if (y + h > height()) { // Clip bottom
-    h = height() - y;
+  if (y + h > ye) { // Clip bottom
+    h = ye - y;
   }
 
   if (getRotation() == 0) {
@@ -2082,8 +3234,9 @@ void GFXcanvas1::drawFastVLine(int16_t x, int16_t y, int16_t h,
    @param  color  Color to fill with
 */
 /**************************************************************************/
-void GFXcanvas1::drawFastHLine(int16_t x, int16_t y, int16_t w,
-                               uint16_t color) {
+void GFXcanvas1V::drawFastHLine(int16_t x, int16_t y, int16_t w,
+                                uint16_t color) {
+  markDirty(x, y, w, 1);
   if (w < 0) { // Convert negative widths to positive equivalent
     w *= -1;
     x -= w - 1;
@@ -2093,17 +3246,19 @@ void GFXcanvas1::drawFastHLine(int16_t x, int16_t y, int16_t w,
     }
   }
 
-  // Edge rejection (no-draw if totally off canvas)
-  if ((y < 0) || (y >= height()) || (x >= width()) || ((x + w - 1) < 0)) {
+  // Edge rejection (no-draw if totally off canvas or clip rect)
+  int16_t xe = min(width(), clip_x2);
+  if ((y < clip_y1) || (y >= min(height(), clip_y2)) || (x >= xe) ||
+      ((x + w - 1) < clip_x1)) {
     return;
   }
 
-  if (x < 0) { // Clip left
-    w += x;
-    x = 0;
+  if (x < clip_x1) { // Clip left
+    w -= clip_x1 - x;
+    x = clip_x1;
   }
-  if (x + w >= width()) { // Clip right
-    w = width() - x;
+  if (x + w >= xe) { // Clip right
+    w = xe - x;
   }
 
   if (getRotation() == 0) {
@@ -2130,39 +3285,31 @@ void GFXcanvas1::drawFastHLine(int16_t x, int16_t y, int16_t w,
 
 /**************************************************************************/
 /*!
-   @brief    Speed optimized vertical line drawing into the raw canvas buffer
+   @brief    Speed optimized vertical line drawing into the raw canvas buffer.
+             Whole pages are written a byte at a time.
    @param    x   Line horizontal start point
    @param    y   Line vertical start point
    @param    h   length of vertical line to be drawn, including first point
    @param    color   Binary (on or off) color to fill with
 */
 /**************************************************************************/
-void GFXcanvas1::drawFastRawVLine(int16_t x, int16_t y, int16_t h,
-                                  uint16_t color) {
+void GFXcanvas1V::drawFastRawVLine(int16_t x, int16_t y, int16_t h,
+                                   uint16_t color) {
   // x & y already in raw (rotation 0) coordinates, no need to transform.
-  int16_t row_bytes = ((WIDTH + 7) / 8);
-  uint8_t *ptr = &buffer[(x / 8) + y * row_bytes];
-
-  if (color > 0) {
-#ifdef __AVR__
-    uint8_t bit_mask = pgm_read_byte(&GFXsetBit[x & 7]);
-#else
-    uint8_t bit_mask = (0x80 >> (x & 7));
-#endif
-    for (int16_t i = 0; i < h; i++) {
-      *ptr |= bit_mask;
-      ptr += row_bytes;
-    }
-  } else {
-#ifdef __AVR__
-    uint8_t bit_mask = pgm_read_byte(&GFXclrBit[x & 7]);
-#else
-    uint8_t bit_mask = ~(0x80 >> (x & 7));
-#endif
-    for (int16_t i = 0; i < h; i++) {
-      *ptr &= bit_mask;
-      ptr += row_bytes;
-    }
+  uint8_t *ptr = &buffer[x + (y / 8) * WIDTH];
+  uint8_t mod = y & 7;
+
+  while (h > 0) {
+    uint8_t mask = 0xFF << mod; // Rows mod..7 of this page
+    if (h < 8 - mod)
+      mask &= 0xFF >> (8 - mod - h); // Line ends within this page
+    if (color > 0)
+      *ptr |= mask;
+    else
+      *ptr &= ~mask;
+    h -= 8 - mod;
+    mod = 0;
+    ptr += WIDTH;
   }
 }
 
@@ -2175,62 +3322,189 @@ void GFXcanvas1::drawFastRawVLine(int16_t x, int16_t y, int16_t h,
    @param    color   Binary (on or off) color to fill with
 */
 /**************************************************************************/
-void GFXcanvas1::drawFastRawHLine(int16_t x, int16_t y, int16_t w,
-                                  uint16_t color) {
+void GFXcanvas1V::drawFastRawHLine(int16_t x, int16_t y, int16_t w,
+                                   uint16_t color) {
   // x & y already in raw (rotation 0) coordinates, no need to transform.
-  int16_t rowBytes = ((WIDTH + 7) / 8);
-  uint8_t *ptr = &buffer[(x / 8) + y * rowBytes];
-  size_t remainingWidthBits = w;
-
-  // check to see if first byte needs to be partially filled
-  if ((x & 7) > 0) {
-    // create bit mask for first byte
-    uint8_t startByteBitMask = 0x00;
-    for (int8_t i = (x & 7); ((i < 8) && (remainingWidthBits > 0)); i++) {
-#ifdef __AVR__
-      startByteBitMask |= pgm_read_byte(&GFXsetBit[i]);
-#else
-      startByteBitMask |= (0x80 >> i);
-#endif
-      remainingWidthBits--;
-    }
-    if (color > 0) {
-      *ptr |= startByteBitMask;
-    } else {
-      *ptr &= ~startByteBitMask;
-    }
+  uint8_t *ptr = &buffer[x + (y / 8) * WIDTH];
+  uint8_t mask = 1 << (y & 7);
 
-    ptr++;
+  if (color > 0) {
+    while (w--)
+      *ptr++ |= mask;
+  } else {
+    mask = ~mask;
+    while (w--)
+      *ptr++ &= mask;
   }
+}
 
-  // do the next remainingWidthBits bits
-  if (remainingWidthBits > 0) {
-    size_t remainingWholeBytes = remainingWidthBits / 8;
-    size_t lastByteBits = remainingWidthBits % 8;
-    uint8_t wholeByteColor = color > 0 ? 0xFF : 0x00;
-
-    memset(ptr, wholeByteColor, remainingWholeBytes);
+// ROW-MAJOR <-> PAGE-MAJOR 1-BIT CONVERSION -------------------------------
 
-    if (lastByteBits > 0) {
-      uint8_t lastByteBitMask = 0x00;
-      for (size_t i = 0; i < lastByteBits; i++) {
-#ifdef __AVR__
-        lastByteBitMask |= pgm_read_byte(&GFXsetBit[i]);
-#else
-        lastByteBitMask |= (0x80 >> i);
-#endif
+/**************************************************************************/
+/*!
+   @brief    Copy a rectangle from a row-major 1-bit image (GFXcanvas1 or
+             drawBitmap() layout: rows of srcStride bytes, MSB = leftmost)
+             into a page-major one (GFXcanvas1V/SH1106 layout:
+             dst[x + (y / 8) * dstWidth], bit 0 = top row of each page).
+             Works in 8x8 tiles through GFXtranspose8x8(); neither corner
+             needs to be byte or page aligned. Pixels outside the
+             rectangle are left alone. No clipping is done; the rectangle
+             must lie within both images.
+   @param    src        Row-major source image
+   @param    srcStride  Bytes per source row, (width + 7) / 8
+   @param    sx         Source rectangle left column
+   @param    sy         Source rectangle top row
+   @param    w          Rectangle width in pixels
+   @param    h          Rectangle height in pixels
+   @param    dst        Page-major destination image
+   @param    dstWidth   Destination width in pixels (bytes per page)
+   @param    dx         Destination left column
+   @param    dy         Destination top row
+*/
+/**************************************************************************/
+void GFXrowsToPages(const uint8_t *src, uint16_t srcStride, int16_t sx,
+                    int16_t sy, int16_t w, int16_t h, uint8_t *dst,
+                    uint16_t dstWidth, int16_t dx, int16_t dy) {
+  for (int16_t j = 0; j < h; j += 8) {
+    uint8_t nr = (h - j < 8) ? h - j : 8;   // Rows in this band
+    uint8_t vm = 0xFF >> (8 - nr);          // ...as bits of a column byte
+    uint8_t shift = (dy + j) & 7;           // Offset within the page
+    uint8_t *lo = &dst[((dy + j) >> 3) * dstWidth + dx];
+    uint8_t *hi = (shift + nr > 8) ? lo + dstWidth : NULL;
+    const uint8_t *row = &src[(sy + j) * srcStride];
+    for (int16_t i = 0; i < w; i += 8) {
+      uint8_t nc = (w - i < 8) ? w - i : 8; // Columns in this tile
+      int16_t b = (sx + i) >> 3;
+      uint8_t o = (sx + i) & 7;
+      uint64_t x = 0;
+      for (uint8_t r = 0; r < nr; r++) { // Gather 8 source pixels per row
+        const uint8_t *p = &row[r * srcStride + b];
+        uint8_t v = p[0] << o;
+        if (o + nc > 8)
+          v |= p[1] >> (8 - o);
+        x |= (uint64_t)v << (r * 8);
       }
-      ptr += remainingWholeBytes;
+      x = GFXtranspose8x8(x);
+      for (uint8_t c = 0; c < nc; c++) { // Merge columns into the page(s)
+        uint8_t col = (x >> ((7 - c) * 8)) & vm;
+        lo[i + c] = (lo[i + c] & ~(vm << shift)) | (col << shift);
+        if (hi)
+          hi[i + c] = (hi[i + c] & ~(vm >> (8 - shift))) | (col >> (8 - shift));
+      }
+    }
+  }
+}
 
-      if (color > 0) {
-        *ptr |= lastByteBitMask;
-      } else {
-        *ptr &= ~lastByteBitMask;
+/**************************************************************************/
+/*!
+   @brief    Copy a rectangle from a page-major 1-bit image into a
+             row-major one; the reverse of GFXrowsToPages(), with the same
+             layouts and rules.
+   @param    src        Page-major source image
+   @param    srcWidth   Source width in pixels (bytes per page)
+   @param    sx         Source rectangle left column
+   @param    sy         Source rectangle top row
+   @param    w          Rectangle width in pixels
+   @param    h          Rectangle height in pixels
+   @param    dst        Row-major destination image
+   @param    dstStride  Bytes per destination row, (width + 7) / 8
+   @param    dx         Destination left column
+   @param    dy         Destination top row
+*/
+/**************************************************************************/
+void GFXpagesToRows(const uint8_t *src, uint16_t srcWidth, int16_t sx,
+                    int16_t sy, int16_t w, int16_t h, uint8_t *dst,
+                    uint16_t dstStride, int16_t dx, int16_t dy) {
+  for (int16_t j = 0; j < h; j += 8) {
+    uint8_t nr = (h - j < 8) ? h - j : 8;
+    uint8_t shift = (sy + j) & 7;
+    const uint8_t *lo = &src[((sy + j) >> 3) * srcWidth + sx];
+    const uint8_t *hi = (shift + nr > 8) ? lo + srcWidth : NULL;
+    uint8_t *row = &dst[(dy + j) * dstStride];
+    for (int16_t i = 0; i < w; i += 8) {
+      uint8_t nc = (w - i < 8) ? w - i : 8;
+      uint8_t hm = 0xFF << (8 - nc); // Valid bits of a row byte
+      uint64_t x = 0;
+      for (uint8_t c = 0; c < nc; c++) { // Gather 8 rows per column
+        uint8_t col = lo[i + c] >> shift;
+        if (hi)
+          col |= hi[i + c] << (8 - shift);
+        x |= (uint64_t)col << ((7 - c) * 8);
+      }
+      x = GFXtranspose8x8(x);
+      int16_t b = (dx + i) >> 3;
+      uint8_t o = (dx + i) & 7;
+      for (uint8_t r = 0; r < nr; r++) { // Merge into the row bytes
+        uint8_t *p = &row[r * dstStride + b];
+        uint8_t v = (x >> (r * 8)) & hm;
+        p[0] = (p[0] & ~(hm >> o)) | (v >> o);
+        if (o + nc > 8)
+          p[1] = (p[1] & ~(hm << (8 - o))) | (v << (8 - o));
       }
     }
   }
 }
 
+/**************************************************************************/
+/*!
+   @brief    Convert a whole row-major 1-bit image (e.g. a GFXcanvas1
+             buffer) to page-major (e.g. a GFXcanvas1V or SH1106 buffer).
+   @param    src   Row-major image, (w + 7) / 8 bytes per row
+   @param    dst   Page-major image, w * ((h + 7) / 8) bytes
+   @param    w     Width in pixels
+   @param    h     Height in pixels
+*/
+/**************************************************************************/
+void GFXrowsToPages(const uint8_t *src, uint8_t *dst, int16_t w, int16_t h) {
+  GFXrowsToPages(src, (w + 7) / 8, 0, 0, w, h, dst, w, 0, 0);
+}
+
+/**************************************************************************/
+/*!
+   @brief    Convert a whole page-major 1-bit image to row-major.
+   @param    src   Page-major image, w * ((h + 7) / 8) bytes
+   @param    dst   Row-major image, (w + 7) / 8 bytes per row
+   @param    w     Width in pixels
+   @param    h     Height in pixels
+*/
+/**************************************************************************/
+void GFXpagesToRows(const uint8_t *src, uint8_t *dst, int16_t w, int16_t h) {
+  GFXpagesToRows(src, w, 0, 0, w, h, dst, (w + 7) / 8, 0, 0);
+}
+
+// Word-at-a-time kernels for the 8- and 16-bit canvases. Once the pointer
+// is aligned, stores are native-word wide (32 bits on ESP32, 64 on most
+// hosts); memcpy() of one word compiles to a single load or store and
+// keeps access to the uint16_t buffer legal under strict aliasing.
+typedef uintptr_t gfx_word_t; ///< Widest plain integer store
+
+static void fill16(uint16_t *dst, uint16_t color, uint32_t n) {
+  for (; n && ((uintptr_t)dst & (sizeof(gfx_word_t) - 1)); n--) // Head
+    *dst++ = color;
+  gfx_word_t w = (gfx_word_t)-1 / 0xFFFF * color; // color in every lane
+  for (; n >= sizeof(gfx_word_t) / 2; n -= sizeof(gfx_word_t) / 2) {
+    memcpy(dst, &w, sizeof(w));
+    dst += sizeof(gfx_word_t) / 2;
+  }
+  while (n--) // Tail
+    *dst++ = color;
+}
+
+static void swap16(uint16_t *buf, uint32_t n) {
+  for (; n && ((uintptr_t)buf & (sizeof(gfx_word_t) - 1)); n--, buf++)
+    *buf = __builtin_bswap16(*buf);
+  const gfx_word_t m = (gfx_word_t)-1 / 0xFFFF * 0x00FF; // Low byte lanes
+  for (; n >= sizeof(gfx_word_t) / 2; n -= sizeof(gfx_word_t) / 2) {
+    gfx_word_t w;
+    memcpy(&w, buf, sizeof(w));
+    w = ((w & m) << 8) | ((w >> 8) & m);
+    memcpy(buf, &w, sizeof(w));
+    buf += sizeof(gfx_word_t) / 2;
+  }
+  for (; n--; buf++)
+    *buf = __builtin_bswap16(*buf);
+}
+
 /**************************************************************************/
 /*!
    @brief    Instatiate a GFX 8-bit canvas context for graphics
@@ -2272,8 +3546,10 @@ GFXcanvas8::~GFXcanvas8(void) {
 */
 /**************************************************************************/
 void GFXcanvas8::drawPixel(int16_t x, int16_t y, uint16_t color) {
+  markDirty(x, y, 1, 1);
   if (buffer) {
-    if ((x < 0) || (y < 0) || (x >= _width) || (y >= _height))
+    if ((x < 0) || (y < 0) || (x >= _width) || (y >= _height) ||
+        clipped(x, y))
       return;
 
     int16_t t;
@@ -2353,6 +3629,11 @@ uint8_t GFXcanvas8::getRawPixel(int16_t x, int16_t y) const {
 */
 /**************************************************************************/
 void GFXcanvas8::fillScreen(uint16_t color) {
+  if (clipActive()) { // Only the clip rect may change
+    fillRect(0, 0, _width, _height, color);
+    return;
+  }
+  markDirty(0, 0, _width, _height);
   if (buffer) {
     memset(buffer, color, WIDTH * HEIGHT);
   }
@@ -2370,6 +3651,7 @@ void GFXcanvas8::fillScreen(uint16_t color) {
 /**************************************************************************/
 void GFXcanvas8::drawFastVLine(int16_t x, int16_t y, int16_t h,
                                uint16_t color) {
+  markDirty(x, y, 1, h);
   if (h < 0) { // Convert negative heights to positive equivalent
     h *= -1;
     y -= h - 1;
@@ -2379,17 +3661,19 @@ void GFXcanvas8::drawFastVLine(int16_t x, int16_t y, int16_t h,
     }
   }
 
-  // Edge rejection (no-draw if totally off canvas)
-  if ((x < 0) || (x >= width()) || (y >= height()) || ((y + h - 1) < 0)) {
+  // Edge rejection (no-draw if totally off canvas or clip rect)
+  int16_t ye = min(height(), clip_y2);
+  if ((x < clip_x1) || (x >= min(width(), clip_x2)) || (y >= ye) ||
+      ((y + h - 1) < clip_y1)) {
     return;
   }
 
-  if (y < 0) { // Clip top
-    h += y;
-    y = 0;
+  if (y < clip_y1) { // Clip top
+    h -= clip_y1 - y;
+    y = clip_y1;
   }
-  if (y + h > height()) { // Clip bottom
-    h = height() - y;
+  if (y + h > ye) { // Clip bottom
+    h = ye - y;
   }
 
   if (getRotation() == 0) {
@@ -2427,6 +3711,7 @@ void GFXcanvas8::drawFastVLine(int16_t x, int16_t y, int16_t h,
 void GFXcanvas8::drawFastHLine(int16_t x, int16_t y, int16_t w,
                                uint16_t color) {
 
+  markDirty(x, y, w, 1);
   if (w < 0) { // Convert negative widths to positive equivalent
     w *= -1;
     x -= w - 1;
@@ -2436,17 +3721,19 @@ void GFXcanvas8::drawFastHLine(int16_t x, int16_t y, int16_t w,
     }
   }
 
-  // Edge rejection (no-draw if totally off canvas)
-  if ((y < 0) || (y >= height()) || (x >= width()) || ((x + w - 1) < 0)) {
+  // Edge rejection (no-draw if totally off canvas or clip rect)
+  int16_t xe = min(width(), clip_x2);
+  if ((y < clip_y1) || (y >= min(height(), clip_y2)) || (x >= xe) ||
+      ((x + w - 1) < clip_x1)) {
     return;
   }
 
-  if (x < 0) { // Clip left
-    w += x;
-    x = 0;
+  if (x < clip_x1) { // Clip left
+    w -= clip_x1 - x;
+    x = clip_x1;
   }
-  if (x + w >= width()) { // Clip right
-    w = width() - x;
+  if (x + w >= xe) { // Clip right
+    w = xe - x;
   }
 
   if (getRotation() == 0) {
@@ -2507,6 +3794,36 @@ void GFXcanvas8::drawFastRawHLine(int16_t x, int16_t y, int16_t w,
   memset(buffer + y * WIDTH + x, color, w);
 }
 
+/**************************************************************************/
+/*!
+   @brief    Fill a rectangle, a row at a time with memset(); a rectangle
+             spanning whole raw rows is a single memset().
+   @param    x   Top left corner x coordinate
+   @param    y   Top left corner y coordinate
+   @param    w   Width in pixels
+   @param    h   Height in pixels
+   @param    color   8-bit Color to fill with. Only lower byte of uint16_t is
+   used.
+*/
+/**************************************************************************/
+void GFXcanvas8::fillRect(int16_t x, int16_t y, int16_t w, int16_t h,
+                          uint16_t color) {
+  markDirty(x, y, w, h);
+  if (h < 0) { // Negative heights, like drawFastVLine(); widths draw nothing
+    h = -h;
+    y -= h - 1;
+  }
+  if (!buffer || (w <= 0) || !clipRawRect(&x, &y, &w, &h))
+    return;
+  uint8_t *ptr = buffer + y * WIDTH + x;
+  if (w == WIDTH) {
+    memset(ptr, color, (uint32_t)w * h);
+  } else {
+    for (; h--; ptr += WIDTH)
+      memset(ptr, color, w);
+  }
+}
+
 /**************************************************************************/
 /*!
    @brief    Instatiate a GFX 16-bit canvas context for graphics
@@ -2549,8 +3866,10 @@ GFXcanvas16::~GFXcanvas16(void) {
 */
 /**************************************************************************/
 void GFXcanvas16::drawPixel(int16_t x, int16_t y, uint16_t color) {
+  markDirty(x, y, 1, 1);
   if (buffer) {
-    if ((x < 0) || (y < 0) || (x >= _width) || (y >= _height))
+    if ((x < 0) || (y < 0) || (x >= _width) || (y >= _height) ||
+        clipped(x, y))
       return;
 
     int16_t t;
@@ -2630,14 +3949,17 @@ uint16_t GFXcanvas16::getRawPixel(int16_t x, int16_t y) const {
 */
 /**************************************************************************/
 void GFXcanvas16::fillScreen(uint16_t color) {
+  if (clipActive()) { // Only the clip rect may change
+    fillRect(0, 0, _width, _height, color);
+    return;
+  }
+  markDirty(0, 0, _width, _height);
   if (buffer) {
     uint8_t hi = color >> 8, lo = color & 0xFF;
     if (hi == lo) {
       memset(buffer, lo, WIDTH * HEIGHT * 2);
     } else {
-      uint32_t i, pixels = WIDTH * HEIGHT;
-      for (i = 0; i < pixels; i++)
-        buffer[i] = color;
+      fill16(buffer, color, (uint32_t)WIDTH * HEIGHT);
     }
   }
 }
@@ -2657,9 +3979,7 @@ void GFXcanvas16::fillScreen(uint16_t color) {
 /**************************************************************************/
 void GFXcanvas16::byteSwap(void) {
   if (buffer) {
-    uint32_t i, pixels = WIDTH * HEIGHT;
-    for (i = 0; i < pixels; i++)
-      buffer[i] = __builtin_bswap16(buffer[i]);
+    swap16(buffer, (uint32_t)WIDTH * HEIGHT);
   }
 }
 
@@ -2674,6 +3994,7 @@ void GFXcanvas16::byteSwap(void) {
 /**************************************************************************/
 void GFXcanvas16::drawFastVLine(int16_t x, int16_t y, int16_t h,
                                 uint16_t color) {
+  markDirty(x, y, 1, h);
   if (h < 0) { // Convert negative heights to positive equivalent
     h *= -1;
     y -= h - 1;
@@ -2683,17 +4004,19 @@ void GFXcanvas16::drawFastVLine(int16_t x, int16_t y, int16_t h,
     }
   }
 
-  // Edge rejection (no-draw if totally off canvas)
-  if ((x < 0) || (x >= width()) || (y >= height()) || ((y + h - 1) < 0)) {
+  // Edge rejection (no-draw if totally off canvas or clip rect)
+  int16_t ye = min(height(), clip_y2);
+  if ((x < clip_x1) || (x >= min(width(), clip_x2)) || (y >= ye) ||
+      ((y + h - 1) < clip_y1)) {
     return;
   }
 
-  if (y < 0) { // Clip top
-    h += y;
-    y = 0;
+  if (y < clip_y1) { // Clip top
+    h -= clip_y1 - y;
+    y = clip_y1;
   }
-  if (y + h > height()) { // Clip bottom
-    h = height() - y;
+  if (y + h > ye) { // Clip bottom
+    h = ye - y;
   }
 
   if (getRotation() == 0) {
@@ -2729,6 +4052,7 @@ void GFXcanvas16::drawFastVLine(int16_t x, int16_t y, int16_t h,
 /**************************************************************************/
 void GFXcanvas16::drawFastHLine(int16_t x, int16_t y, int16_t w,
                                 uint16_t color) {
+  markDirty(x, y, w, 1);
   if (w < 0) { // Convert negative widths to positive equivalent
     w *= -1;
     x -= w - 1;
@@ -2738,17 +4062,19 @@ void GFXcanvas16::drawFastHLine(int16_t x, int16_t y, int16_t w,
     }
   }
 
-  // Edge rejection (no-draw if totally off canvas)
-  if ((y < 0) || (y >= height()) || (x >= width()) || ((x + w - 1) < 0)) {
+  // Edge rejection (no-draw if totally off canvas or clip rect)
+  int16_t xe = min(width(), clip_x2);
+  if ((y < clip_y1) || (y >= min(height(), clip_y2)) || (x >= xe) ||
+      ((x + w - 1) < clip_x1)) {
     return;
   }
 
-  if (x < 0) { // Clip left
-    w += x;
-    x = 0;
+  if (x < clip_x1) { // Clip left
+    w -= clip_x1 - x;
+    x = clip_x1;
   }
-  if (x + w >= width()) { // Clip right
-    w = width() - x;
+  if (x + w >= xe) { // Clip right
+    w = xe - x;
   }
 
   if (getRotation() == 0) {
@@ -2804,8 +4130,34 @@ void GFXcanvas16::drawFastRawVLine(int16_t x, int16_t y, int16_t h,
 void GFXcanvas16::drawFastRawHLine(int16_t x, int16_t y, int16_t w,
                                    uint16_t color) {
   // x & y already in raw (rotation 0) coordinates, no need to transform.
-  uint32_t buffer_index = y * WIDTH + x;
-  for (uint32_t i = buffer_index; i < buffer_index + w; i++) {
-    buffer[i] = color;
+  fill16(buffer + y * WIDTH + x, color, w);
+}
+
+/**************************************************************************/
+/*!
+   @brief    Fill a rectangle, a row at a time with word-wide stores; a
+             rectangle spanning whole raw rows is filled in one go.
+   @param    x   Top left corner x coordinate
+   @param    y   Top left corner y coordinate
+   @param    w   Width in pixels
+   @param    h   Height in pixels
+   @param    color   16-bit 5-6-5 Color to fill with
+*/
+/**************************************************************************/
+void GFXcanvas16::fillRect(int16_t x, int16_t y, int16_t w, int16_t h,
+                           uint16_t color) {
+  markDirty(x, y, w, h);
+  if (h < 0) { // Negative heights, like drawFastVLine(); widths draw nothing
+    h = -h;
+    y -= h - 1;
+  }
+  if (!buffer || (w <= 0) || !clipRawRect(&x, &y, &w, &h))
+    return;
+  uint16_t *ptr = buffer + y * WIDTH + x;
+  if (w == WIDTH) {
+    fill16(ptr, color, (uint32_t)w * h);
+  } else {
+    for (; h--; ptr += WIDTH)
+      fill16(ptr, color, w);
   }
 }
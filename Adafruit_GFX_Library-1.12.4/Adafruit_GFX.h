@@ -12,6 +12,72 @@
 #include <Adafruit_I2CDevice.h>
 #include <Adafruit_SPIDevice.h>
 
+#ifndef GFX_DIRTY_RECTS
+#define GFX_DIRTY_RECTS 4 ///< Max dirty rectangles tracked before merging
+#endif
+
+/// A rectangle in raw (unrotated) framebuffer coordinates
+typedef struct {
+  int16_t x; ///< Left edge
+  int16_t y; ///< Top edge
+  int16_t w; ///< Width in pixels
+  int16_t h; ///< Height in pixels
+} GFXrect;
+
+#ifndef GFX_LAYOUT_MAX_CHARS
+#define GFX_LAYOUT_MAX_CHARS 32 ///< Longest string a GFXtextLayout can hold
+#endif
+static_assert(GFX_LAYOUT_MAX_CHARS <= 255,
+              "GFXtextLayout len and count are 8-bit; keep "
+              "GFX_LAYOUT_MAX_CHARS at 255 or below");
+
+/// One positioned character within a GFXtextLayout
+typedef struct {
+  int16_t x; ///< drawChar() X, relative to the layout origin
+  int16_t y; ///< drawChar() Y (baseline for custom fonts), relative to origin
+  uint8_t c; ///< Character code
+} GFXlayoutGlyph;
+
+/// A string measured and laid out once by Adafruit_GFX::layoutText(), so it
+/// can be drawn (and its bounds queried) repeatedly without re-walking the
+/// font's glyph table. Coordinates are relative to the layout origin, which
+/// behaves like print()ing from cursor column 0.
+typedef struct {
+  const GFXfont *font; ///< Font laid out with (NULL = classic)
+  uint32_t hash;       ///< FNV-1a hash of the source text
+  int16_t wrapWidth;   ///< Right edge used for wrapping, 0 if wrap was off
+  uint8_t size_x;      ///< Horizontal text magnification
+  uint8_t size_y;      ///< Vertical text magnification
+  uint8_t len;         ///< Length of the source text
+  uint8_t count;       ///< Number of entries used in glyphs[]
+  uint16_t stamp;      ///< Last-use tick, maintained by GFXtextLayoutCache
+  int16_t x1;          ///< Bounding box left edge, relative to origin
+  int16_t y1;          ///< Bounding box top edge, relative to origin
+  uint16_t w;          ///< Bounding box width, 0 if nothing is drawn
+  uint16_t h;          ///< Bounding box height, 0 if nothing is drawn
+  int16_t advance_x;   ///< Cursor X after the last character
+  int16_t advance_y;   ///< Cursor Y after the last character
+  char text[GFX_LAYOUT_MAX_CHARS];             ///< Copy of the source text
+  GFXlayoutGlyph glyphs[GFX_LAYOUT_MAX_CHARS]; ///< Characters with a bitmap
+} GFXtextLayout;
+
+/// A small least-recently-used cache of GFXtextLayouts, keyed by font, text
+/// size, wrap width and string contents. Pass to layoutText() so labels that
+/// are redrawn every frame skip the measure pass.
+class GFXtextLayoutCache {
+public:
+  GFXtextLayoutCache(uint8_t n = 4);
+  ~GFXtextLayoutCache(void);
+  void clear(void);
+  GFXtextLayout *find(const GFXtextLayout *key, const char *str);
+  GFXtextLayout *reserve(void);
+
+private:
+  GFXtextLayout *entries; // Allocated in constructor, NULL on failure
+  uint8_t n;              // Number of entries
+  uint16_t tick;          // Incremented on every use, never 0
+};
+
 /// A generic graphics superclass that can handle all sorts of drawing. At a
 /// minimum you can subclass and provide drawPixel(). At a maximum you can do a
 /// ton of overriding to optimize. Used for any/all Adafruit displays!
@@ -60,6 +126,11 @@ public:
   virtual void fillRect(int16_t x, int16_t y, int16_t w, int16_t h,
                         uint16_t color);
   virtual void fillScreen(uint16_t color);
+  // 1-bit bitmap blit behind every drawBitmap() overload; override to
+  // write whole bytes into a native framebuffer layout
+  virtual void blitBitmap(int16_t x, int16_t y, const uint8_t *bitmap,
+                          int16_t w, int16_t h, uint16_t color, uint16_t bg,
+                          bool transparent, bool progmem);
   // Optional and probably not necessary to change
   virtual void drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
                         uint16_t color);
@@ -121,9 +192,16 @@ public:
                      int16_t *x1, int16_t *y1, uint16_t *w, uint16_t *h);
   void getTextBounds(const String &str, int16_t x, int16_t y, int16_t *x1,
                      int16_t *y1, uint16_t *w, uint16_t *h);
+  bool layoutText(const char *str, GFXtextLayout *layout);
+  const GFXtextLayout *layoutText(const char *str, GFXtextLayoutCache *cache);
+  void drawTextLayout(const GFXtextLayout *layout, int16_t x, int16_t y,
+                      uint16_t color);
+  void drawTextLayout(const GFXtextLayout *layout, int16_t x, int16_t y,
+                      uint16_t color, uint16_t bg);
   void setTextSize(uint8_t s);
   void setTextSize(uint8_t sx, uint8_t sy);
   void setFont(const GFXfont *f = NULL);
+  void setFontRLE(const GFXfontRLE *f);
 
   /**********************************************************************/
   /*!
@@ -233,9 +311,92 @@ public:
   /************************************************************************/
   int16_t getCursorY(void) const { return cursor_y; };
 
+  // DIRTY REGION API
+  // Primitives record the area they touch so drivers can flush only what
+  // changed. Rectangles are kept in raw (rotation 0) coordinates.
+
+  /************************************************************************/
+  /*!
+    @brief  Record that a region of the display has changed. Called once by
+            each drawing primitive with its bounding box; subclasses call it
+            from drawPixel() and any primitives they override. Nested calls
+            made while a primitive is drawing are ignored here, inline, so
+            the per-pixel calls inside a primitive cost only that test.
+    @param  x  Left edge, in current rotation coordinates
+    @param  y  Top edge, in current rotation coordinates
+    @param  w  Width in pixels (negative extends to the left)
+    @param  h  Height in pixels (negative extends upward)
+  */
+  /************************************************************************/
+  void markDirty(int16_t x, int16_t y, int16_t w, int16_t h) {
+    if (!dirtyHold)
+      mergeDirty(x, y, w, h);
+  }
+  void clearDirty(void);
+  bool getDirtyBounds(GFXrect *r) const;
+
+  /************************************************************************/
+  /*!
+    @brief  Get the list of regions changed since the last clearDirty()
+    @param  count  Set to the number of rectangles in the list
+    @returns  Pointer to the rectangles, in raw (unrotated) coordinates
+  */
+  /************************************************************************/
+  const GFXrect *getDirtyRects(uint8_t *count) const {
+    *count = dirtyCount;
+    return dirtyRects;
+  }
+
+  // CLIP RECT API
+  // Drawing is limited to the clip rect (current rotation coordinates).
+  // Primitives whose bounding box misses it are rejected before any
+  // per-pixel work. setRotation() resets it to the full display.
+  void setClipRect(int16_t x, int16_t y, int16_t w, int16_t h);
+  void resetClipRect(void);
+  void getClipRect(int16_t *x, int16_t *y, int16_t *w, int16_t *h) const;
+
 protected:
+  /// Statically dispatched primitives bracket their work the same way
+  template <class D> friend class Adafruit_GFX_Direct;
+
   void charBounds(unsigned char c, int16_t *x, int16_t *y, int16_t *minx,
                   int16_t *miny, int16_t *maxx, int16_t *maxy);
+  bool startPrimitive(int16_t x, int16_t y, int16_t w, int16_t h);
+  void mergeDirty(int16_t x, int16_t y, int16_t w, int16_t h);
+
+  /************************************************************************/
+  /*!
+    @brief  End a primitive begun with a successful startPrimitive()
+  */
+  /************************************************************************/
+  void endPrimitive(void) { dirtyHold--; }
+  bool clipRawRect(int16_t *x, int16_t *y, int16_t *w, int16_t *h) const;
+  bool clipLine(bool steep, int16_t *x0, int16_t *y0, int16_t *x1,
+                int16_t *err, int16_t dy, int16_t ystep) const;
+
+  /************************************************************************/
+  /*!
+    @brief  Test a pixel against the clip rect (not the display bounds)
+    @param  x  X coordinate, in current rotation coordinates
+    @param  y  Y coordinate, in current rotation coordinates
+    @returns  true if the pixel lies outside the clip rect
+  */
+  /************************************************************************/
+  bool clipped(int16_t x, int16_t y) const {
+    return (x < clip_x1) || (y < clip_y1) || (x >= clip_x2) || (y >= clip_y2);
+  }
+
+  /************************************************************************/
+  /*!
+    @brief  Check whether the clip rect excludes any part of the display
+    @returns  true if a clip rect narrower than the display is set
+  */
+  /************************************************************************/
+  bool clipActive(void) const {
+    return (clip_x1 > 0) || (clip_y1 > 0) || (clip_x2 < _width) ||
+           (clip_y2 < _height);
+  }
+
   int16_t WIDTH;        ///< This is the 'raw' display width - never changes
   int16_t HEIGHT;       ///< This is the 'raw' display height - never changes
   int16_t _width;       ///< Display width as modified by current rotation
@@ -250,6 +411,15 @@ protected:
   bool wrap;            ///< If set, 'wrap' text at right edge of display
   bool _cp437;          ///< If set, use correct CP437 charset (default is off)
   GFXfont *gfxFont;     ///< Pointer to special font
+  bool gfxFontRLE;      ///< If set, gfxFont glyph bitmaps are RLE-encoded
+  GFXrect dirtyRects[GFX_DIRTY_RECTS]; ///< Changed regions, raw coordinates
+  uint8_t dirtyCount; ///< Number of entries used in dirtyRects
+  uint8_t dirtyHold;  ///< Nesting depth of primitives that already marked
+                      ///< their bounds; markDirty() is a no-op while > 0
+  int16_t clip_x1; ///< Clip rect left edge (inclusive)
+  int16_t clip_y1; ///< Clip rect top edge (inclusive)
+  int16_t clip_x2; ///< Clip rect right edge (exclusive), 0x7FFF if unclipped
+  int16_t clip_y2; ///< Clip rect bottom edge (exclusive), 0x7FFF if unclipped
 };
 
 /// A simple drawn button UI element
@@ -343,6 +513,68 @@ private:
 #endif
 };
 
+/// A GFX 1-bit canvas context using the vertical-byte "page" layout of
+/// SSD1306/SH1106-style OLEDs: buffer[x + (y / 8) * WIDTH], bit 0 = top row
+/// of each page. Can be blitted into such displays without per-pixel work.
+class GFXcanvas1V : public Adafruit_GFX {
+public:
+  GFXcanvas1V(uint16_t w, uint16_t h, bool allocate_buffer = true);
+  ~GFXcanvas1V(void);
+  void drawPixel(int16_t x, int16_t y, uint16_t color);
+  void fillScreen(uint16_t color);
+  void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color);
+  void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color);
+  bool getPixel(int16_t x, int16_t y) const;
+  /**********************************************************************/
+  /*!
+    @brief    Get a pointer to the internal buffer memory
+    @returns  A pointer to the allocated buffer
+  */
+  /**********************************************************************/
+  uint8_t *getBuffer(void) const { return buffer; }
+
+protected:
+  bool getRawPixel(int16_t x, int16_t y) const;
+  void drawFastRawVLine(int16_t x, int16_t y, int16_t h, uint16_t color);
+  void drawFastRawHLine(int16_t x, int16_t y, int16_t w, uint16_t color);
+  uint8_t *buffer;   ///< Raster data: no longer private, allow subclass access
+  bool buffer_owned; ///< If true, destructor will free buffer, else it will do
+                     ///< nothing
+};
+
+/**************************************************************************/
+/*!
+   @brief    Transpose an 8x8 bit matrix held as 8 bytes in a 64-bit word:
+             bit b of byte r moves to bit r of byte b. Branch-free SWAR,
+             three delta swaps. This is the shared step between row-major
+             1-bit images (GFXcanvas1, bitmaps: byte r = row r, MSB = left)
+             and page layouts (GFXcanvas1V, SH1106: one byte per column,
+             bit 0 = top): pack rows into bytes 0..7 and column c comes out
+             in byte 7 - c, and the reverse.
+   @param    x   Matrix to transpose
+   @returns  Transposed matrix; applying it twice gives back x
+*/
+/**************************************************************************/
+static inline uint64_t GFXtranspose8x8(uint64_t x) {
+  uint64_t t;
+  t = (x ^ (x >> 7)) & 0x00AA00AA00AA00AAULL;
+  x ^= t ^ (t << 7);
+  t = (x ^ (x >> 14)) & 0x0000CCCC0000CCCCULL;
+  x ^= t ^ (t << 14);
+  t = (x ^ (x >> 28)) & 0x00000000F0F0F0F0ULL;
+  x ^= t ^ (t << 28);
+  return x;
+}
+
+void GFXrowsToPages(const uint8_t *src, uint16_t srcStride, int16_t sx,
+                    int16_t sy, int16_t w, int16_t h, uint8_t *dst,
+                    uint16_t dstWidth, int16_t dx, int16_t dy);
+void GFXpagesToRows(const uint8_t *src, uint16_t srcWidth, int16_t sx,
+                    int16_t sy, int16_t w, int16_t h, uint8_t *dst,
+                    uint16_t dstStride, int16_t dx, int16_t dy);
+void GFXrowsToPages(const uint8_t *src, uint8_t *dst, int16_t w, int16_t h);
+void GFXpagesToRows(const uint8_t *src, uint8_t *dst, int16_t w, int16_t h);
+
 /// A GFX 8-bit canvas context for graphics
 class GFXcanvas8 : public Adafruit_GFX {
 public:
@@ -352,6 +584,7 @@ public:
   void fillScreen(uint16_t color);
   void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color);
   void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color);
+  void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
   uint8_t getPixel(int16_t x, int16_t y) const;
   /**********************************************************************/
   /*!
@@ -380,6 +613,7 @@ public:
   void byteSwap(void);
   void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color);
   void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color);
+  void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
   uint16_t getPixel(int16_t x, int16_t y) const;
   /**********************************************************************/
   /*!
@@ -0,0 +1,399 @@
+/*!
+ * @file Adafruit_GFX_Direct.h
+ *
+ * Statically dispatched drawing primitives for code that knows the concrete
+ * display class at compile time (typically a template such as
+ * RoboEyes<Adafruit_SH1106>).
+ *
+ * The Adafruit_GFX primitives reach the driver through virtual calls at
+ * every level (fillRoundRect() -> writeFillRect() -> fillRect() ->
+ * writeFastVLine() -> drawFastVLine()): an indirect call per span, and no
+ * chance for the compiler to inline a span writer it can see. The
+ * Adafruit_GFX_Direct<D> wrapper implements the same primitives as
+ * templates and calls D::drawPixel(), D::drawFastHLine() and
+ * D::drawFastVLine() with qualified, non-virtual calls. The output is
+ * pixel-for-pixel what the Adafruit_GFX versions draw, including dirty
+ * tracking and clip rect rejection.
+ *
+ * Spans are drawn with the driver's drawFastHLine()/drawFastVLine(), so
+ * this suits framebuffer drivers; for SPITFT-style drivers the plain
+ * virtual API (which batches SPI transactions) is usually the better
+ * choice.
+ *
+ * Nothing changes for code that uses the virtual API.
+ *
+ * BSD license, all text above must be included in any redistribution.
+ */
+
+#ifndef _ADAFRUIT_GFX_DIRECT_H
+#define _ADAFRUIT_GFX_DIRECT_H
+
+#include "Adafruit_GFX.h"
+
+// The larger primitives are kept out of line (one copy per display type)
+// so that every call site doesn't get its own inlined copy; the span
+// writers they call are still bound statically.
+#if defined(__GNUC__)
+#define GFX_DIRECT_OUTLINE __attribute__((noinline))
+#else
+#define GFX_DIRECT_OUTLINE
+#endif
+
+/// Drawing primitives bound at compile time to display class D
+template <class D> class Adafruit_GFX_Direct {
+public:
+  /**********************************************************************/
+  /*!
+    @brief  Wrap a display for statically dispatched drawing
+    @param  display  Display object; must outlive this wrapper
+  */
+  /**********************************************************************/
+  Adafruit_GFX_Direct(D &display) : d(display) {}
+
+  /**********************************************************************/
+  /*!
+    @brief  Get the wrapped display, for everything not offered here
+    @returns  Reference to the display object
+  */
+  /**********************************************************************/
+  D &display(void) const { return d; }
+
+  /**********************************************************************/
+  /*!
+    @brief  Draw a pixel (see Adafruit_GFX::drawPixel())
+    @param  x      X coordinate
+    @param  y      Y coordinate
+    @param  color  Color to draw with
+  */
+  /**********************************************************************/
+  void drawPixel(int16_t x, int16_t y, uint16_t color) {
+    d.D::drawPixel(x, y, color);
+  }
+
+  /**********************************************************************/
+  /*!
+    @brief  Draw a vertical line (see Adafruit_GFX::drawFastVLine())
+    @param  x      Top-most x coordinate
+    @param  y      Top-most y coordinate
+    @param  h      Height in pixels
+    @param  color  Color to draw with
+  */
+  /**********************************************************************/
+  void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) {
+    d.D::drawFastVLine(x, y, h, color);
+  }
+
+  /**********************************************************************/
+  /*!
+    @brief  Draw a horizontal line (see Adafruit_GFX::drawFastHLine())
+    @param  x      Left-most x coordinate
+    @param  y      Left-most y coordinate
+    @param  w      Width in pixels
+    @param  color  Color to draw with
+  */
+  /**********************************************************************/
+  void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) {
+    d.D::drawFastHLine(x, y, w, color);
+  }
+
+  /**********************************************************************/
+  /*!
+    @brief  Fill a rectangle (see Adafruit_GFX::fillRect()). If D has its
+            own fillRect() (a span or page filler), that is called for
+            positive sizes instead of one vertical line per column.
+    @param  x      Top left corner x coordinate
+    @param  y      Top left corner y coordinate
+    @param  w      Width in pixels
+    @param  h      Height in pixels
+    @param  color  Color to fill with
+  */
+  /**********************************************************************/
+  GFX_DIRECT_OUTLINE
+  void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    if (!gfx().startPrimitive(x, y, w, h))
+      return;
+    if (ownFillRect(&D::fillRect) && (w > 0) && (h > 0)) {
+      d.D::fillRect(x, y, w, h, color);
+    } else {
+      for (int16_t i = x; i < x + w; i++)
+        d.D::drawFastVLine(i, y, h, color);
+    }
+    gfx().endPrimitive();
+  }
+
+  /**********************************************************************/
+  /*!
+    @brief  Draw a line (see Adafruit_GFX::drawLine())
+    @param  x0     Start point x coordinate
+    @param  y0     Start point y coordinate
+    @param  x1     End point x coordinate
+    @param  y1     End point y coordinate
+    @param  color  Color to draw with
+  */
+  /**********************************************************************/
+  GFX_DIRECT_OUTLINE
+  void drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                uint16_t color) {
+    if (!gfx().startPrimitive(min(x0, x1), min(y0, y1), abs(x1 - x0) + 1,
+                              abs(y1 - y0) + 1))
+      return;
+    if (x0 == x1) {
+      if (y0 > y1)
+        _swap(y0, y1);
+      d.D::drawFastVLine(x0, y0, y1 - y0 + 1, color);
+    } else if (y0 == y1) {
+      if (x0 > x1)
+        _swap(x0, x1);
+      d.D::drawFastHLine(x0, y0, x1 - x0 + 1, color);
+    } else {
+      writeLine(x0, y0, x1, y1, color);
+    }
+    gfx().endPrimitive();
+  }
+
+  /**********************************************************************/
+  /*!
+    @brief  Fill a circle (see Adafruit_GFX::fillCircle())
+    @param  x0     Center-point x coordinate
+    @param  y0     Center-point y coordinate
+    @param  r      Radius of circle
+    @param  color  Color to fill with
+  */
+  /**********************************************************************/
+  GFX_DIRECT_OUTLINE
+  void fillCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color) {
+    bool held = (r >= 0); // Else each line drawn marks itself
+    if (held && !gfx().startPrimitive(x0 - r, y0 - r, 2 * r + 1, 2 * r + 1))
+      return;
+    d.D::drawFastVLine(x0, y0 - r, 2 * r + 1, color);
+    fillCircleHelper(x0, y0, r, 3, 0, color);
+    if (held)
+      gfx().endPrimitive();
+  }
+
+  /**********************************************************************/
+  /*!
+    @brief  Fill a rounded rectangle (see Adafruit_GFX::fillRoundRect())
+    @param  x      Top left corner x coordinate
+    @param  y      Top left corner y coordinate
+    @param  w      Width in pixels
+    @param  h      Height in pixels
+    @param  r      Radius of corner rounding
+    @param  color  Color to fill with
+  */
+  /**********************************************************************/
+  GFX_DIRECT_OUTLINE
+  void fillRoundRect(int16_t x, int16_t y, int16_t w, int16_t h, int16_t r,
+                     uint16_t color) {
+    int16_t max_radius = ((w < h) ? w : h) / 2; // 1/2 minor axis
+    if (r > max_radius)
+      r = max_radius;
+    // Degenerate sizes draw outside the box; then each line marks itself
+    bool held = (w > 0) && (h > 0) && (r >= 0);
+    if (held && !gfx().startPrimitive(x, y, w, h))
+      return;
+    fillRect(x + r, y, w - 2 * r, h, color);
+    fillCircleHelper(x + w - r - 1, y + r, r, 1, h - 2 * r - 1, color);
+    fillCircleHelper(x + r, y + r, r, 2, h - 2 * r - 1, color);
+    if (held)
+      gfx().endPrimitive();
+  }
+
+  /**********************************************************************/
+  /*!
+    @brief  Fill a triangle (see Adafruit_GFX::fillTriangle())
+    @param  x0     Vertex #0 x coordinate
+    @param  y0     Vertex #0 y coordinate
+    @param  x1     Vertex #1 x coordinate
+    @param  y1     Vertex #1 y coordinate
+    @param  x2     Vertex #2 x coordinate
+    @param  y2     Vertex #2 y coordinate
+    @param  color  Color to fill with
+  */
+  /**********************************************************************/
+  GFX_DIRECT_OUTLINE
+  void fillTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                    int16_t x2, int16_t y2, uint16_t color) {
+    if (!gfx().startPrimitive(min(min(x0, x1), x2), min(min(y0, y1), y2),
+                              max(max(x0, x1), x2) - min(min(x0, x1), x2) + 1,
+                              max(max(y0, y1), y2) - min(min(y0, y1), y2) + 1))
+      return;
+
+    int16_t a, b, y, last;
+
+    // Sort coordinates by Y order (y2 >= y1 >= y0)
+    if (y0 > y1) {
+      _swap(y0, y1);
+      _swap(x0, x1);
+    }
+    if (y1 > y2) {
+      _swap(y2, y1);
+      _swap(x2, x1);
+    }
+    if (y0 > y1) {
+      _swap(y0, y1);
+      _swap(x0, x1);
+    }
+
+    if (y0 == y2) { // All on the same line
+      a = b = x0;
+      if (x1 < a)
+        a = x1;
+      else if (x1 > b)
+        b = x1;
+      if (x2 < a)
+        a = x2;
+      else if (x2 > b)
+        b = x2;
+      d.D::drawFastHLine(a, y0, b - a + 1, color);
+      gfx().endPrimitive();
+      return;
+    }
+
+    int16_t dx01 = x1 - x0, dy01 = y1 - y0, dx02 = x2 - x0, dy02 = y2 - y0,
+            dx12 = x2 - x1, dy12 = y2 - y1;
+    int32_t sa = 0, sb = 0;
+
+    // Upper part: segments 0-1 and 0-2, including scanline y1 only for a
+    // flat-bottomed triangle (see Adafruit_GFX::fillTriangle())
+    if (y1 == y2)
+      last = y1;
+    else
+      last = y1 - 1;
+
+    for (y = y0; y <= last; y++) {
+      a = x0 + sa / dy01;
+      b = x0 + sb / dy02;
+      sa += dx01;
+      sb += dx02;
+      if (a > b)
+        _swap(a, b);
+      d.D::drawFastHLine(a, y, b - a + 1, color);
+    }
+
+    // Lower part: segments 0-2 and 1-2, skipped if y1=y2
+    sa = (int32_t)dx12 * (y - y1);
+    sb = (int32_t)dx02 * (y - y0);
+    for (; y <= y2; y++) {
+      a = x1 + sa / dy12;
+      b = x0 + sb / dy02;
+      sa += dx12;
+      sb += dx02;
+      if (a > b)
+        _swap(a, b);
+      d.D::drawFastHLine(a, y, b - a + 1, color);
+    }
+    gfx().endPrimitive();
+  }
+
+private:
+  D &d; ///< The display drawn to
+
+  /// Base-class view of the display, for the protected primitive bracket
+  Adafruit_GFX &gfx(void) const { return d; }
+
+  // Whether &D::fillRect names an override declared in D (or a class
+  // between it and Adafruit_GFX) rather than Adafruit_GFX::fillRect()
+  static constexpr bool ownFillRect(void (Adafruit_GFX::*)(int16_t, int16_t,
+                                                           int16_t, int16_t,
+                                                           uint16_t)) {
+    return false;
+  }
+  template <class C>
+  static constexpr bool ownFillRect(void (C::*)(int16_t, int16_t, int16_t,
+                                                int16_t, uint16_t)) {
+    return true;
+  }
+
+  static void _swap(int16_t &a, int16_t &b) {
+    int16_t t = a;
+    a = b;
+    b = t;
+  }
+
+  // Bresenham line, as Adafruit_GFX::writeLine()
+  GFX_DIRECT_OUTLINE
+  void writeLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                 uint16_t color) {
+#if defined(ESP8266)
+    yield();
+#endif
+    bool steep = abs(y1 - y0) > abs(x1 - x0);
+    if (steep) {
+      _swap(x0, y0);
+      _swap(x1, y1);
+    }
+    if (x0 > x1) {
+      _swap(x0, x1);
+      _swap(y0, y1);
+    }
+
+    int16_t dx = x1 - x0, dy = abs(y1 - y0);
+    int16_t err = dx / 2;
+    int16_t ystep = (y0 < y1) ? 1 : -1;
+    if (!gfx().clipLine(steep, &x0, &y0, &x1, &err, dy, ystep))
+      return;
+
+    for (; x0 <= x1; x0++) {
+      if (steep)
+        d.D::drawPixel(y0, x0, color);
+      else
+        d.D::drawPixel(x0, y0, color);
+      err -= dy;
+      if (err < 0) {
+        y0 += ystep;
+        err += dx;
+      }
+    }
+  }
+
+  // Half-circle fill, as Adafruit_GFX::fillCircleHelper()
+  GFX_DIRECT_OUTLINE
+  void fillCircleHelper(int16_t x0, int16_t y0, int16_t r, uint8_t corners,
+                        int16_t delta, uint16_t color) {
+    bool held = (r >= 0) && (delta >= 0); // Else each line marks itself
+    if (held && !gfx().startPrimitive(x0 - r, y0 - r, 2 * r + 1,
+                                      2 * r + 1 + delta))
+      return;
+
+    int16_t f = 1 - r;
+    int16_t ddF_x = 1;
+    int16_t ddF_y = -2 * r;
+    int16_t x = 0;
+    int16_t y = r;
+    int16_t px = x;
+    int16_t py = y;
+
+    delta++; // Avoid some +1's in the loop
+
+    while (x < y) {
+      if (f >= 0) {
+        y--;
+        ddF_y += 2;
+        f += ddF_y;
+      }
+      x++;
+      ddF_x += 2;
+      f += ddF_x;
+      // Avoid double-drawing lines (matters for INVERSE drawing modes)
+      if (x < (y + 1)) {
+        if (corners & 1)
+          d.D::drawFastVLine(x0 + x, y0 - y, 2 * y + delta, color);
+        if (corners & 2)
+          d.D::drawFastVLine(x0 - x, y0 - y, 2 * y + delta, color);
+      }
+      if (y != py) {
+        if (corners & 1)
+          d.D::drawFastVLine(x0 + py, y0 - px, 2 * px + delta, color);
+        if (corners & 2)
+          d.D::drawFastVLine(x0 - py, y0 - px, 2 * px + delta, color);
+        py = y;
+      }
+      px = x;
+    }
+    if (held)
+      gfx().endPrimitive();
+  }
+};
+
+#endif // _ADAFRUIT_GFX_DIRECT_H
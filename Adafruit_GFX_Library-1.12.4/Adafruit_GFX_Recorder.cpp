@@ -0,0 +1,503 @@
+/*!
+ * @file Adafruit_GFX_Recorder.cpp
+ *
+ * Primitive recording for band (strip) renderers: drawing calls are kept
+ * as a list that can be replayed into each band of the screen in turn.
+ *
+ * BSD license, all text above must be included in any redistribution.
+ */
+
+#if !defined(__AVR_ATtiny85__) && !defined(__AVR_ATtiny84__)
+
+#include "Adafruit_GFX_Recorder.h"
+
+#ifndef min
+#define min(a, b) (((a) < (b)) ? (a) : (b))
+#endif
+#ifndef max
+#define max(a, b) (((a) > (b)) ? (a) : (b))
+#endif
+
+// Recorded primitive codes
+#define GFXSTRIP_RECT 0      ///< fillRect(x, y, w, h), also pixels and lines
+#define GFXSTRIP_LINE 1      ///< drawLine(x0, y0, x1, y1)
+#define GFXSTRIP_CIRCLE 2    ///< fillCircle(x0, y0, r)
+#define GFXSTRIP_ROUNDRECT 3 ///< fillRoundRect(x, y, w, h, r)
+#define GFXSTRIP_TRIANGLE 4  ///< fillTriangle(x0, y0, x1, y1, x2, y2)
+#define GFXSTRIP_CLIP 5      ///< Later primitives are clipped to x1, y1, x2, y2
+#define GFXSTRIP_COLOR 14    ///< Later primitives draw in this color
+#define GFXSTRIP_LONG 15     ///< Primitive code, then 16-bit arguments
+
+/// Number of arguments of each primitive code
+static const uint8_t opArgs[] = {4, 4, 3, 5, 6, 4};
+
+/**************************************************************************/
+/*!
+   @brief    Unpack one 12-bit argument of a list entry
+    @param    e   List entry
+    @param    i   Argument, 0-4
+    @returns  The argument, sign-extended
+*/
+/**************************************************************************/
+static inline int16_t opField(GFXstripOp e, uint8_t i) {
+  int16_t v = (e >> (4 + 12 * i)) & 0xFFF;
+  return (v ^ 0x800) - 0x800;
+}
+
+/**************************************************************************/
+/*!
+   @brief    Check whether arguments fit the packed 12-bit form
+    @param    n   Number of arguments
+    @param    a   The arguments
+    @returns  true if all are within -2048..2047
+*/
+/**************************************************************************/
+static bool opPacked(uint8_t n, const int16_t *a) {
+  for (uint8_t i = 0; i < n; i++) {
+    if ((a[i] < -2048) || (a[i] >= 2048))
+      return false;
+  }
+  return true;
+}
+
+/**************************************************************************/
+/*!
+   @brief    Count the list entries a primitive takes
+    @param    n   Number of arguments
+    @param    a   The arguments
+    @returns  Entries needed
+*/
+/**************************************************************************/
+static uint8_t opEntries(uint8_t n, const int16_t *a) {
+  return opPacked(n, a) ? (n + 4) / 5 : 1 + (n + 3) / 4;
+}
+
+/**************************************************************************/
+/*!
+   @brief    Instantiate a recorder. Call beginOps() before drawing.
+    @param    w     Screen width, in pixels
+    @param    h     Screen height, in pixels
+    @param    ops   Capacity of the list, in 8-byte entries. When it is
+                    full, overflow() is asked for a fallback; without one
+                    the list grows.
+*/
+/**************************************************************************/
+GFXrecorder::GFXrecorder(uint16_t w, uint16_t h, uint16_t ops)
+    : Adafruit_GFX(w, h), op_max(ops ? ops : 1) {
+  restart();
+}
+
+/**************************************************************************/
+/*!
+   @brief    Delete the recorder and free its primitive list.
+*/
+/**************************************************************************/
+GFXrecorder::~GFXrecorder(void) { free(op_list); }
+
+/**************************************************************************/
+/*!
+   @brief    Allocate the primitive list, if not done already.
+    @returns  true on success, false if out of memory
+*/
+/**************************************************************************/
+bool GFXrecorder::beginOps(void) {
+  return op_list ||
+         (op_list = (GFXstripOp *)malloc(op_max * sizeof(GFXstripOp)));
+}
+
+/**************************************************************************/
+/*!
+   @brief    Empty the list and go back to recording.
+*/
+/**************************************************************************/
+void GFXrecorder::restart(void) {
+  op_count = 0;
+  last_op = 0xFFFF;
+  op_color = 0x10000;
+  op_clip[0] = op_clip[1] = 0;
+  op_clip[2] = _width;
+  op_clip[3] = _height;
+  direct = NULL;
+}
+
+/**************************************************************************/
+/*!
+   @brief    Get the clip rect as it applies to drawing now
+    @param    c   Set to its left, top, right and bottom edges (exclusive
+                  right and bottom), within the screen
+*/
+/**************************************************************************/
+void GFXrecorder::clipBounds(int16_t *c) const {
+  c[0] = clip_x1;
+  c[1] = clip_y1;
+  c[2] = min(_width, clip_x2);
+  c[3] = min(_height, clip_y2);
+}
+
+/**************************************************************************/
+/*!
+   @brief    Append the entries of one primitive to the list, which has
+             room for them (see opEntries())
+    @param    op  One of the GFXSTRIP_* primitive codes
+    @param    n   Number of arguments, opArgs[op]
+    @param    a   The arguments
+*/
+/**************************************************************************/
+void GFXrecorder::put(uint8_t op, uint8_t n, const int16_t *a) {
+  if (opPacked(n, a)) { // Five arguments to an entry, each tagged with op
+    for (uint8_t i = 0; i < n; i += 5) {
+      GFXstripOp e = op;
+      for (uint8_t j = 0; (j < 5) && (i + j < n); j++)
+        e |= (GFXstripOp)(a[i + j] & 0xFFF) << (4 + 12 * j);
+      op_list[op_count++] = e;
+    }
+  } else { // Four whole arguments to an entry, after the code
+    op_list[op_count++] = GFXSTRIP_LONG | (op << 4);
+    for (uint8_t i = 0; i < n; i += 4) {
+      GFXstripOp e = 0;
+      for (uint8_t j = 0; (j < 4) && (i + j < n); j++)
+        e |= (GFXstripOp)(uint16_t)a[i + j] << (16 * j);
+      op_list[op_count++] = e;
+    }
+  }
+}
+
+/**************************************************************************/
+/*!
+   @brief    Make room for n more list entries. A full list is handed to
+             the target overflow() supplies, or grown if there is none.
+    @param    n   Entries needed
+    @returns  true if there is room, false if the primitive is to be drawn
+              straight to fallback() instead, or dropped if that is NULL
+*/
+/**************************************************************************/
+bool GFXrecorder::reserve(uint8_t n) {
+  if (direct || !op_list)
+    return false;
+  if (op_count + n <= op_max)
+    return true;
+  Adafruit_GFX *target = overflow();
+  if (target) {
+    replay(*target);
+    restart();
+    direct = target;
+    return false;
+  }
+  while (op_count + n > op_max) {
+    if (op_max > 0x7FFF)
+      return false;
+    GFXstripOp *grown = (GFXstripOp *)realloc(
+        op_list, (uint32_t)op_max * 2 * sizeof(GFXstripOp));
+    if (!grown)
+      return false;
+    op_list = grown;
+    op_max *= 2;
+  }
+  return true;
+}
+
+/**************************************************************************/
+/*!
+   @brief    Append a primitive to the list, preceded by a color entry if
+             its color differs from the last one recorded and a clip entry
+             if the clip rect does.
+    @param    op      One of the GFXSTRIP_* primitive codes
+    @param    color   Color to draw with
+    @param    n       Number of arguments, opArgs[op]
+    @param    a0      First argument of the primitive
+    @param    a1      Second argument
+    @param    a2      Third argument
+    @param    a3      Fourth argument
+    @param    a4      Fifth argument
+    @param    a5      Sixth argument
+    @returns  true if recorded, false if the caller is to draw it straight
+              to fallback() instead (its clip rect is then set to this
+              one's), or drop it if that is NULL
+*/
+/**************************************************************************/
+bool GFXrecorder::record(uint8_t op, uint16_t color, uint8_t n, int16_t a0,
+                         int16_t a1, int16_t a2, int16_t a3, int16_t a4,
+                         int16_t a5) {
+  int16_t a[6] = {a0, a1, a2, a3, a4, a5};
+  int16_t clip[4];
+  clipBounds(clip);
+  bool newClip = memcmp(clip, op_clip, sizeof(clip)) != 0;
+  uint8_t entries = opEntries(n, a);
+  if (color != op_color)
+    entries++;
+  if (newClip)
+    entries += opEntries(4, clip);
+  if (!reserve(entries)) {
+    if (direct)
+      direct->setClipRect(clip[0], clip[1], clip[2] - clip[0],
+                          clip[3] - clip[1]);
+    return false;
+  }
+
+  if (color != op_color) {
+    op_list[op_count++] = GFXSTRIP_COLOR | ((GFXstripOp)color << 4);
+    op_color = color;
+  }
+  if (newClip) {
+    put(GFXSTRIP_CLIP, 4, clip);
+    memcpy(op_clip, clip, sizeof(clip));
+  }
+  last_op = op_count;
+  put(op, n, a);
+  return true;
+}
+
+/**************************************************************************/
+/*!
+   @brief    Add a pixel to the rectangle recorded last, if that is a
+             one-pixel-wide column it extends downwards or a one-pixel-high
+             row it extends to the right, in the same color. Text and
+             outlines then cost an entry per run rather than per pixel.
+    @param    x       X coordinate
+    @param    y       Y coordinate
+    @param    color   Color to draw with
+    @returns  true if the pixel was added
+*/
+/**************************************************************************/
+bool GFXrecorder::extendRun(int16_t x, int16_t y, uint16_t color) {
+  int16_t clip[4];
+  clipBounds(clip);
+  if (!op_count || (last_op != op_count - 1) || (color != op_color) ||
+      memcmp(clip, op_clip, sizeof(clip)))
+    return false;
+  GFXstripOp e = op_list[last_op];
+  if ((e & 0xF) != GFXSTRIP_RECT)
+    return false;
+  int16_t rx = opField(e, 0), ry = opField(e, 1);
+  int16_t rw = opField(e, 2), rh = opField(e, 3);
+  if ((rw == 1) && (x == rx) && (y == ry + rh) && (rh < 2047))
+    rh++;
+  else if ((rh == 1) && (y == ry) && (x == rx + rw) && (rw < 2047))
+    rw++;
+  else
+    return false;
+  op_list[last_op] = GFXSTRIP_RECT | ((GFXstripOp)(rx & 0xFFF) << 4) |
+                     ((GFXstripOp)(ry & 0xFFF) << 16) |
+                     ((GFXstripOp)rw << 28) | ((GFXstripOp)rh << 40);
+  return true;
+}
+
+/**************************************************************************/
+/*!
+   @brief    Forget everything drawn so far and start over from a black
+             screen, whatever the clip rect. Nothing is sent until
+             display().
+*/
+/**************************************************************************/
+void GFXrecorder::clearDisplay(void) {
+  restart();
+  background = 0;
+}
+
+/**************************************************************************/
+/*!
+   @brief    Fill the screen, or the clip rect if one is set. A whole
+             screen fill overdraws everything recorded before, so the list
+             is emptied and the color becomes the background each band
+             starts from.
+    @param    color   Color to fill with
+*/
+/**************************************************************************/
+void GFXrecorder::fillScreen(uint16_t color) {
+  if (clipActive()) {
+    fillRect(0, 0, _width, _height, color);
+    return;
+  }
+  restart();
+  background = color;
+}
+
+/**************************************************************************/
+/*!
+   @brief    Record a pixel (see Adafruit_GFX::drawPixel())
+    @param    x       X coordinate
+    @param    y       Y coordinate
+    @param    color   Color to draw with
+*/
+/**************************************************************************/
+void GFXrecorder::drawPixel(int16_t x, int16_t y, uint16_t color) {
+  if ((x < 0) || (x >= _width) || (y < 0) || (y >= _height) || clipped(x, y))
+    return;
+  if (!direct && extendRun(x, y, color))
+    return;
+  if (!record(GFXSTRIP_RECT, color, 4, x, y, 1, 1) && direct)
+    direct->drawPixel(x, y, color);
+}
+
+/**************************************************************************/
+/*!
+   @brief    Record a vertical line (see Adafruit_GFX::drawFastVLine())
+    @param    x       Top-most x coordinate
+    @param    y       Top-most y coordinate
+    @param    h       Height in pixels
+    @param    color   Color to draw with
+*/
+/**************************************************************************/
+void GFXrecorder::drawFastVLine(int16_t x, int16_t y, int16_t h,
+                                uint16_t color) {
+  if (!record(GFXSTRIP_RECT, color, 4, x, y, 1, h) && direct)
+    direct->drawFastVLine(x, y, h, color);
+}
+
+/**************************************************************************/
+/*!
+   @brief    Record a horizontal line (see Adafruit_GFX::drawFastHLine())
+    @param    x       Left-most x coordinate
+    @param    y       Left-most y coordinate
+    @param    w       Width in pixels
+    @param    color   Color to draw with
+*/
+/**************************************************************************/
+void GFXrecorder::drawFastHLine(int16_t x, int16_t y, int16_t w,
+                                uint16_t color) {
+  if (!record(GFXSTRIP_RECT, color, 4, x, y, w, 1) && direct)
+    direct->drawFastHLine(x, y, w, color);
+}
+
+/**************************************************************************/
+/*!
+   @brief    Record a filled rectangle (see Adafruit_GFX::fillRect())
+    @param    x       Top left corner x coordinate
+    @param    y       Top left corner y coordinate
+    @param    w       Width in pixels
+    @param    h       Height in pixels
+    @param    color   Color to fill with
+*/
+/**************************************************************************/
+void GFXrecorder::fillRect(int16_t x, int16_t y, int16_t w, int16_t h,
+                           uint16_t color) {
+  if (!record(GFXSTRIP_RECT, color, 4, x, y, w, h) && direct)
+    direct->fillRect(x, y, w, h, color);
+}
+
+/**************************************************************************/
+/*!
+   @brief    Record a line (see Adafruit_GFX::drawLine())
+    @param    x0      Start point x coordinate
+    @param    y0      Start point y coordinate
+    @param    x1      End point x coordinate
+    @param    y1      End point y coordinate
+    @param    color   Color to draw with
+*/
+/**************************************************************************/
+void GFXrecorder::drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                           uint16_t color) {
+  if (!record(GFXSTRIP_LINE, color, 4, x0, y0, x1, y1) && direct)
+    direct->drawLine(x0, y0, x1, y1, color);
+}
+
+/**************************************************************************/
+/*!
+   @brief    Record a filled circle (see Adafruit_GFX::fillCircle())
+    @param    x0      Center-point x coordinate
+    @param    y0      Center-point y coordinate
+    @param    r       Radius of circle
+    @param    color   Color to fill with
+*/
+/**************************************************************************/
+void GFXrecorder::fillCircle(int16_t x0, int16_t y0, int16_t r,
+                             uint16_t color) {
+  if (!record(GFXSTRIP_CIRCLE, color, 3, x0, y0, r) && direct)
+    direct->fillCircle(x0, y0, r, color);
+}
+
+/**************************************************************************/
+/*!
+   @brief    Record a filled rounded rectangle (see
+             Adafruit_GFX::fillRoundRect())
+    @param    x       Top left corner x coordinate
+    @param    y       Top left corner y coordinate
+    @param    w       Width in pixels
+    @param    h       Height in pixels
+    @param    r       Radius of corner rounding
+    @param    color   Color to fill with
+*/
+/**************************************************************************/
+void GFXrecorder::fillRoundRect(int16_t x, int16_t y, int16_t w, int16_t h,
+                                int16_t r, uint16_t color) {
+  if (!record(GFXSTRIP_ROUNDRECT, color, 5, x, y, w, h, r) && direct)
+    direct->fillRoundRect(x, y, w, h, r, color);
+}
+
+/**************************************************************************/
+/*!
+   @brief    Record a filled triangle (see Adafruit_GFX::fillTriangle())
+    @param    x0      Vertex #0 x coordinate
+    @param    y0      Vertex #0 y coordinate
+    @param    x1      Vertex #1 x coordinate
+    @param    y1      Vertex #1 y coordinate
+    @param    x2      Vertex #2 x coordinate
+    @param    y2      Vertex #2 y coordinate
+    @param    color   Color to fill with
+*/
+/**************************************************************************/
+void GFXrecorder::fillTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                               int16_t x2, int16_t y2, uint16_t color) {
+  if (!record(GFXSTRIP_TRIANGLE, color, 6, x0, y0, x1, y1, x2, y2) && direct)
+    direct->fillTriangle(x0, y0, x1, y1, x2, y2, color);
+}
+
+/**************************************************************************/
+/*!
+   @brief    Replay the primitive list into another GFX object, usually
+             a band canvas whose clip rect rejects primitives that miss it.
+             Clip rects set while recording apply within that one, which
+             is put back afterwards.
+    @param    target  Object to draw into
+*/
+/**************************************************************************/
+void GFXrecorder::replay(Adafruit_GFX &target) {
+  uint16_t color = 0;
+  int16_t a[6], bx, by, bw, bh;
+  target.getClipRect(&bx, &by, &bw, &bh);
+  for (uint16_t i = 0; i < op_count;) {
+    GFXstripOp e = op_list[i++];
+    uint8_t op = e & 0xF;
+    if (op == GFXSTRIP_COLOR) {
+      color = e >> 4;
+      continue;
+    }
+    if (op == GFXSTRIP_LONG) {
+      op = (e >> 4) & 0xF;
+      for (uint8_t k = 0; k < opArgs[op]; k++)
+        a[k] = (int16_t)(op_list[i + k / 4] >> (16 * (k % 4)));
+      i += (opArgs[op] + 3) / 4;
+    } else {
+      for (uint8_t k = 0; k < opArgs[op]; k++)
+        a[k] = opField(op_list[i - 1 + k / 5], k % 5);
+      i += (opArgs[op] - 1) / 5;
+    }
+    switch (op) {
+    case GFXSTRIP_RECT:
+      target.fillRect(a[0], a[1], a[2], a[3], color);
+      break;
+    case GFXSTRIP_LINE:
+      target.drawLine(a[0], a[1], a[2], a[3], color);
+      break;
+    case GFXSTRIP_CIRCLE:
+      target.fillCircle(a[0], a[1], a[2], color);
+      break;
+    case GFXSTRIP_ROUNDRECT:
+      target.fillRoundRect(a[0], a[1], a[2], a[3], a[4], color);
+      break;
+    case GFXSTRIP_TRIANGLE:
+      target.fillTriangle(a[0], a[1], a[2], a[3], a[4], a[5], color);
+      break;
+    case GFXSTRIP_CLIP: // The recorded clip rect, within the target's own
+      a[0] = max(a[0], bx);
+      a[1] = max(a[1], by);
+      a[2] = min(a[2], (int16_t)(bx + bw));
+      a[3] = min(a[3], (int16_t)(by + bh));
+      target.setClipRect(a[0], a[1], a[2] - a[0], a[3] - a[1]);
+      break;
+    }
+  }
+  target.setClipRect(bx, by, bw, bh);
+}
+
+#endif // end __AVR_ATtiny85__ __AVR_ATtiny84__
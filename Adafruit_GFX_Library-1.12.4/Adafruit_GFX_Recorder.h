@@ -0,0 +1,178 @@
+/*!
+ * @file Adafruit_GFX_Recorder.h
+ *
+ * Primitive recording for band (strip) renderers.
+ *
+ * A renderer without a whole-screen framebuffer can't draw a primitive
+ * once and be done with it: every band of the screen it sends has to be
+ * drawn from the same scene. GFXrecorder keeps that scene as a list of
+ * primitives. Drawing calls append to the list, clearDisplay() or
+ * fillScreen() empties it, and replay() draws the list into any
+ * Adafruit_GFX, typically a canvas covering one band whose clip rect
+ * rejects primitives that miss it.
+ *
+ * List entries are 8 bytes. Most primitives take one entry, with their
+ * arguments packed as 12-bit fields; a triangle takes two, and arguments
+ * beyond +/-2047 a longer form. The color is an entry of its own, only
+ * when it changes, and single pixels drawn in a row or column extend one
+ * rectangle rather than adding an entry each. The clip rect is recorded
+ * the same way, as an entry whenever it changes. When the list is full a
+ * subclass can supply a whole-screen target through overflow(): the list
+ * is replayed into it and drawing goes straight there until the screen is
+ * next cleared. Otherwise the list grows.
+ *
+ * Adafruit_SPITFT_Strip (colour TFTs) and Adafruit_SH1106_Band (SH1106
+ * page bands) are built on it.
+ *
+ * BSD license, all text above must be included in any redistribution.
+ */
+
+#ifndef _ADAFRUIT_GFX_RECORDER_H_
+#define _ADAFRUIT_GFX_RECORDER_H_
+
+#if !defined(__AVR_ATtiny85__) && !defined(__AVR_ATtiny84__)
+
+#include "Adafruit_GFX.h"
+
+/// One 8-byte entry of a GFXrecorder list: a code in the low 4 bits, then
+/// five 12-bit signed arguments (or a 16-bit color)
+typedef uint64_t GFXstripOp;
+
+/// Records drawing as a list of primitives, to be replayed band by band
+class GFXrecorder : public Adafruit_GFX {
+public:
+  GFXrecorder(uint16_t w, uint16_t h, uint16_t ops = 128);
+  ~GFXrecorder(void);
+
+  void clearDisplay(void);
+
+  void drawPixel(int16_t x, int16_t y, uint16_t color);
+  void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color);
+  void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color);
+  void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+  void fillScreen(uint16_t color);
+  void drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                uint16_t color);
+  void fillCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color);
+  void fillRoundRect(int16_t x, int16_t y, int16_t w, int16_t h, int16_t r,
+                     uint16_t color);
+  void fillTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                    int16_t x2, int16_t y2, uint16_t color);
+
+  /**********************************************************************/
+  /*!
+    @brief    Number of 8-byte list entries used since the screen was last
+              cleared
+    @returns  Entry count
+  */
+  /**********************************************************************/
+  uint16_t getOpCount(void) const { return op_count; }
+
+protected:
+  bool beginOps(void);
+  void replay(Adafruit_GFX &target);
+
+  /**********************************************************************/
+  /*!
+    @brief    Called when the list is full. A subclass may return a
+              whole-screen target, set up for this recorder's rotation and
+              filled with the background; the list is then replayed into
+              it and drawing goes straight to it until the next
+              clearDisplay() or fillScreen().
+    @returns  The target, or NULL to grow the list instead
+  */
+  /**********************************************************************/
+  virtual Adafruit_GFX *overflow(void) { return NULL; }
+
+  /**********************************************************************/
+  /*!
+    @brief    Where drawing goes since the list overflowed
+    @returns  The target overflow() returned, or NULL while recording
+  */
+  /**********************************************************************/
+  Adafruit_GFX *fallback(void) const { return direct; }
+
+  uint16_t background = 0; ///< Color of the last clear
+
+private:
+  bool record(uint8_t op, uint16_t color, uint8_t n, int16_t a0 = 0,
+              int16_t a1 = 0, int16_t a2 = 0, int16_t a3 = 0,
+              int16_t a4 = 0, int16_t a5 = 0);
+  bool reserve(uint8_t n);
+  void put(uint8_t op, uint8_t n, const int16_t *a);
+  bool extendRun(int16_t x, int16_t y, uint16_t color);
+  void clipBounds(int16_t *c) const;
+  void restart(void);
+
+  GFXstripOp *op_list = NULL;   ///< Recorded primitives
+  uint16_t op_count = 0;        ///< Entries used in op_list
+  uint16_t op_max;              ///< Capacity of op_list, in entries
+  uint16_t last_op = 0xFFFF;    ///< Entry of the last primitive recorded
+  uint32_t op_color = 0x10000;  ///< Color entries now draw in, none yet
+  int16_t op_clip[4];           ///< Clip rect they draw in, see clipBounds()
+  Adafruit_GFX *direct = NULL;  ///< See fallback()
+};
+
+/// Adafruit_GFX_Direct for a recorder R: each primitive is recorded once,
+/// rather than broken into spans on the way in. Specialize
+/// Adafruit_GFX_Direct<R> as a subclass of this for each recorder type.
+template <class R> class GFXrecorderDirect {
+public:
+  /**********************************************************************/
+  /*!
+    @brief  Wrap a recorder for statically dispatched drawing
+    @param  display  Recorder object; must outlive this wrapper
+  */
+  /**********************************************************************/
+  GFXrecorderDirect(R &display) : d(display) {}
+
+  /**********************************************************************/
+  /*!
+    @brief    Get the wrapped recorder, for everything not offered here
+    @returns  Reference to the recorder object
+  */
+  /**********************************************************************/
+  R &display(void) const { return d; }
+
+  /// Record a pixel (see Adafruit_GFX::drawPixel())
+  void drawPixel(int16_t x, int16_t y, uint16_t color) {
+    d.GFXrecorder::drawPixel(x, y, color);
+  }
+  /// Record a vertical line (see Adafruit_GFX::drawFastVLine())
+  void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) {
+    d.GFXrecorder::drawFastVLine(x, y, h, color);
+  }
+  /// Record a horizontal line (see Adafruit_GFX::drawFastHLine())
+  void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) {
+    d.GFXrecorder::drawFastHLine(x, y, w, color);
+  }
+  /// Record a filled rectangle (see Adafruit_GFX::fillRect())
+  void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    d.GFXrecorder::fillRect(x, y, w, h, color);
+  }
+  /// Record a line (see Adafruit_GFX::drawLine())
+  void drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                uint16_t color) {
+    d.GFXrecorder::drawLine(x0, y0, x1, y1, color);
+  }
+  /// Record a filled circle (see Adafruit_GFX::fillCircle())
+  void fillCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color) {
+    d.GFXrecorder::fillCircle(x0, y0, r, color);
+  }
+  /// Record a filled rounded rectangle (see Adafruit_GFX::fillRoundRect())
+  void fillRoundRect(int16_t x, int16_t y, int16_t w, int16_t h, int16_t r,
+                     uint16_t color) {
+    d.GFXrecorder::fillRoundRect(x, y, w, h, r, color);
+  }
+  /// Record a filled triangle (see Adafruit_GFX::fillTriangle())
+  void fillTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                    int16_t x2, int16_t y2, uint16_t color) {
+    d.GFXrecorder::fillTriangle(x0, y0, x1, y1, x2, y2, color);
+  }
+
+private:
+  R &d; ///< The wrapped recorder
+};
+
+#endif // end __AVR_ATtiny85__ __AVR_ATtiny84__
+#endif // _ADAFRUIT_GFX_RECORDER_H_
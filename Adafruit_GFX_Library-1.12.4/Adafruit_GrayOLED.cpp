@@ -152,6 +152,8 @@ Adafruit_GrayOLED::~Adafruit_GrayOLED(void) {
     free(buffer);
     buffer = NULL;
   }
+  free(span_x1);
+  free(span_x2);
   if (spi_dev)
     delete spi_dev;
   if (i2c_dev)
@@ -228,6 +230,12 @@ bool Adafruit_GrayOLED::_init(uint8_t addr, bool reset) {
       !(buffer = (uint8_t *)malloc(_bpp * WIDTH * ((HEIGHT + 7) / 8)))) {
     return false;
   }
+  // and the per row/page dirty spans
+  if ((!span_x1) && !(span_x1 = (int16_t *)malloc(bands() * sizeof(int16_t))))
+    return false;
+  if ((!span_x2) && !(span_x2 = (int16_t *)malloc(bands() * sizeof(int16_t))))
+    return false;
+  clearDirtySpans();
 
   // Reset OLED if requested and reset pin specified in constructor
   if (reset && (rstPin >= 0)) {
@@ -283,7 +291,9 @@ bool Adafruit_GrayOLED::_init(uint8_t addr, bool reset) {
             commands as needed by one's own application.
 */
 void Adafruit_GrayOLED::drawPixel(int16_t x, int16_t y, uint16_t color) {
-  if ((x >= 0) && (x < width()) && (y >= 0) && (y < height())) {
+  markDirty(x, y, 1, 1);
+  if ((x >= 0) && (x < width()) && (y >= 0) && (y < height()) &&
+      !clipped(x, y)) {
     // Pixel is in-bounds. Rotate coordinates if needed.
     switch (getRotation()) {
     case 1:
@@ -300,11 +310,7 @@ void Adafruit_GrayOLED::drawPixel(int16_t x, int16_t y, uint16_t color) {
       break;
     }
 
-    // adjust dirty window
-    window_x1 = min(window_x1, x);
-    window_y1 = min(window_y1, y);
-    window_x2 = max(window_x2, x);
-    window_y2 = max(window_y2, y);
+    markSpans(x, y, 1, 1);
 
     if (_bpp == 1) {
       switch (color) {
@@ -335,6 +341,156 @@ void Adafruit_GrayOLED::drawPixel(int16_t x, int16_t y, uint16_t color) {
   }
 }
 
+/*!
+    @brief  Draw a horizontal line. Clipped and rotated once, then written
+            as a span (see fillRect()).
+    @param  x
+            Leftmost column.
+    @param  y
+            Row.
+    @param  w
+            Width in pixels; negative widths extend left from x.
+    @param  color
+            Pixel color, as for drawPixel().
+    @note   Changes buffer contents only, no immediate effect on display.
+*/
+void Adafruit_GrayOLED::drawFastHLine(int16_t x, int16_t y, int16_t w,
+                                      uint16_t color) {
+  fillRect(x, y, w, 1, color);
+}
+
+/*!
+    @brief  Draw a vertical line. Clipped and rotated once, then written
+            as a span (see fillRect()).
+    @param  x
+            Column.
+    @param  y
+            Topmost row.
+    @param  h
+            Height in pixels; negative heights extend up from y.
+    @param  color
+            Pixel color, as for drawPixel().
+    @note   Changes buffer contents only, no immediate effect on display.
+*/
+void Adafruit_GrayOLED::drawFastVLine(int16_t x, int16_t y, int16_t h,
+                                      uint16_t color) {
+  fillRect(x, y, 1, h, color);
+}
+
+/*!
+    @brief  Fill a rectangle. The rectangle is clipped and rotated to buffer
+            coordinates once, the dirty window is updated once, and the
+            buffer is then written a byte at a time: whole 8-row pages
+            (1 bpp) or pixel pairs (4 bpp) with memset(), and only the
+            partial bytes at the edges are masked.
+    @param  x
+            Leftmost column.
+    @param  y
+            Topmost row.
+    @param  w
+            Width in pixels; negative widths extend left from x.
+    @param  h
+            Height in pixels; negative heights extend up from y.
+    @param  color
+            Pixel color, as for drawPixel().
+    @note   Changes buffer contents only, no immediate effect on display.
+*/
+void Adafruit_GrayOLED::fillRect(int16_t x, int16_t y, int16_t w, int16_t h,
+                                 uint16_t color) {
+  markDirty(x, y, w, h);
+  if (w < 0) { // Convert negative sizes to positive equivalent
+    w = -w;
+    x -= w - 1;
+  }
+  if (h < 0) {
+    h = -h;
+    y -= h - 1;
+  }
+
+  // Clip to the display and clip rect
+  int16_t xe = min(width(), clip_x2), ye = min(height(), clip_y2);
+  if (x < clip_x1) {
+    w -= clip_x1 - x;
+    x = clip_x1;
+  }
+  if (y < clip_y1) {
+    h -= clip_y1 - y;
+    y = clip_y1;
+  }
+  if (x + w > xe)
+    w = xe - x;
+  if (y + h > ye)
+    h = ye - y;
+  if ((w <= 0) || (h <= 0))
+    return;
+
+  // Rotate the rectangle to buffer coordinates
+  switch (getRotation()) {
+  case 1:
+    grayoled_swap(x, y);
+    grayoled_swap(w, h);
+    x = WIDTH - x - w;
+    break;
+  case 2:
+    x = WIDTH - x - w;
+    y = HEIGHT - y - h;
+    break;
+  case 3:
+    grayoled_swap(x, y);
+    grayoled_swap(w, h);
+    y = HEIGHT - y - h;
+    break;
+  }
+
+  markSpans(x, y, w, h);
+
+  if (_bpp == 1) {
+    if (color > MONOOLED_INVERSE)
+      return;
+    // Pages are 8 rows tall, one byte per column
+    for (int16_t page = y / 8; page <= (y + h - 1) / 8; page++) {
+      uint8_t mask = 0xFF;
+      if (page == y / 8)
+        mask &= 0xFF << (y & 7);
+      if (page == (y + h - 1) / 8)
+        mask &= 0xFF >> (7 - ((y + h - 1) & 7));
+      uint8_t *ptr = &buffer[x + page * WIDTH];
+      int16_t n = w;
+      if ((mask == 0xFF) && (color != MONOOLED_INVERSE)) {
+        memset(ptr, (color == MONOOLED_WHITE) ? 0xFF : 0x00, n);
+      } else if (color == MONOOLED_WHITE) {
+        while (n--)
+          *ptr++ |= mask;
+      } else if (color == MONOOLED_BLACK) {
+        mask = ~mask;
+        while (n--)
+          *ptr++ &= mask;
+      } else {
+        while (n--)
+          *ptr++ ^= mask;
+      }
+    }
+  }
+  if (_bpp == 4) {
+    // Rows of packed nibbles, even column in the high nibble
+    uint8_t c = color & 0xF;
+    for (int16_t j = 0; j < h; j++) {
+      uint8_t *ptr = &buffer[x / 2 + ((y + j) * WIDTH / 2)];
+      int16_t n = w;
+      if (x & 1) { // Leading odd column, low nibble
+        *ptr = (*ptr & 0xF0) | c;
+        ptr++;
+        n--;
+      }
+      memset(ptr, c * 0x11, n / 2); // Whole bytes
+      if (n & 1) { // Trailing even column, high nibble
+        ptr += n / 2;
+        *ptr = (*ptr & 0x0F) | (c << 4);
+      }
+    }
+  }
+}
+
 /*!
     @brief  Clear contents of display buffer (set all pixels to off).
     @note   Changes buffer contents only, no immediate effect on display.
@@ -343,11 +499,132 @@ void Adafruit_GrayOLED::drawPixel(int16_t x, int16_t y, uint16_t color) {
 */
 void Adafruit_GrayOLED::clearDisplay(void) {
   memset(buffer, 0, _bpp * WIDTH * ((HEIGHT + 7) / 8));
+  markDirty(0, 0, _width, _height);
   // set max dirty window
-  window_x1 = 0;
-  window_y1 = 0;
-  window_x2 = WIDTH - 1;
-  window_y2 = HEIGHT - 1;
+  markSpans(0, 0, WIDTH, HEIGHT);
+}
+
+// DIRTY SPANS -------------------------------------------------------------
+
+/*!
+    @brief  Grow the dirty window and the per row (4 bpp) or per page
+            (1 bpp) dirty column spans to cover a rectangle.
+    @param  x
+            Leftmost column, in unrotated buffer coordinates.
+    @param  y
+            Topmost row, in unrotated buffer coordinates.
+    @param  w
+            Width in pixels, > 0.
+    @param  h
+            Height in pixels, > 0.
+*/
+void Adafruit_GrayOLED::markSpans(int16_t x, int16_t y, int16_t w, int16_t h) {
+  int16_t x2 = x + w - 1, y2 = y + h - 1;
+  window_x1 = min(window_x1, x);
+  window_y1 = min(window_y1, y);
+  window_x2 = max(window_x2, x2);
+  window_y2 = max(window_y2, y2);
+  if (!span_x1)
+    return;
+  if (_bpp == 1) { // one span per 8-row page
+    y /= 8;
+    y2 /= 8;
+  }
+  for (; y <= y2; y++) {
+    if (x < span_x1[y])
+      span_x1[y] = x;
+    if (x2 > span_x2[y])
+      span_x2[y] = x2;
+  }
+}
+
+/*!
+    @brief  Forget all dirty spans and empty the dirty window. Sub-classes
+            call this once display() has sent everything it was given by
+            nextDirtySpan().
+*/
+void Adafruit_GrayOLED::clearDirtySpans(void) {
+  window_x1 = 1024;
+  window_y1 = 1024;
+  window_x2 = -1;
+  window_y2 = -1;
+  if (!span_x1)
+    return;
+  for (int16_t b = bands(); b--;) {
+    span_x1[b] = 0x7FFF;
+    span_x2[b] = -1;
+  }
+}
+
+/*!
+    @brief  Iterate over the changed parts of the buffer, for sub-class
+            display() implementations that only want to send those.
+            Consecutive dirty rows (4 bpp) or pages (1 bpp) are merged into
+            one window while the merged window costs fewer bytes than
+            sending the next row/page as a window of its own, including
+            GRAYOLED_SPAN_COST bytes of set-up for each window. Two small
+            changes far apart therefore come back as two small windows
+            rather than one that covers the panel.
+    @param  band
+            Cursor: set to 0 before the first call, then pass back
+            unchanged.
+    @param  x1
+            Returns the window's leftmost column.
+    @param  y1
+            Returns the window's topmost row (a page boundary for 1 bpp).
+    @param  x2
+            Returns the window's rightmost column, inclusive.
+    @param  y2
+            Returns the window's bottom row, inclusive (the last row of a
+            page for 1 bpp).
+    @return true if a window was returned, false once there are no more.
+    @note   All coordinates are unrotated buffer coordinates, as for
+            window_x1 etc. Call clearDirtySpans() after the last window has
+            been sent.
+*/
+bool Adafruit_GrayOLED::nextDirtySpan(int16_t *band, int16_t *x1, int16_t *y1,
+                                      int16_t *x2, int16_t *y2) {
+  int16_t n = bands(), b = *band;
+  if (!span_x1) { // Not begun; fall back to the whole dirty window
+    if ((b > 0) || (window_x2 < window_x1) || (window_y2 < window_y1))
+      return false;
+    *x1 = window_x1;
+    *y1 = window_y1;
+    *x2 = window_x2;
+    *y2 = window_y2;
+    *band = 1;
+    return true;
+  }
+  while ((b < n) && (span_x2[b] < span_x1[b])) // Skip clean rows/pages
+    b++;
+  if (b >= n) {
+    *band = b;
+    return false;
+  }
+
+  int16_t first = b, lo = span_x1[b], hi = span_x2[b];
+  for (b++; (b < n) && (span_x2[b] >= span_x1[b]); b++) {
+    int16_t mlo = min(lo, span_x1[b]), mhi = max(hi, span_x2[b]);
+    int32_t merged = (int32_t)(b - first + 1) * bandBytes(mlo, mhi);
+    int32_t split = (int32_t)(b - first) * bandBytes(lo, hi) +
+                    bandBytes(span_x1[b], span_x2[b]) + GRAYOLED_SPAN_COST;
+    if (merged > split)
+      break;
+    lo = mlo;
+    hi = mhi;
+  }
+
+  *x1 = lo;
+  *x2 = hi;
+  if (_bpp == 1) {
+    *y1 = first * 8;
+    *y2 = min(b * 8, (int)HEIGHT) - 1;
+  } else {
+    *y1 = first;
+    *y2 = b - 1;
+  }
+  *band = b;
+  return true;
 }
 
 /*!
@@ -41,6 +41,14 @@
 #define MONOOLED_WHITE 1   ///< Default white 'color' for monochrome OLEDS
 #define MONOOLED_INVERSE 2 ///< Default inversion command for monochrome OLEDS
 
+#ifndef GRAYOLED_SPAN_COST
+/// Approximate bytes of command/addressing overhead a display() pays to
+/// start a new window. nextDirtySpan() merges neighbouring dirty rows or
+/// pages into one window while that sends fewer bytes than starting a
+/// new one.
+#define GRAYOLED_SPAN_COST 8
+#endif
+
 /*!
     @brief  Class that stores state and functions for interacting with
             generic grayscale OLED displays.
@@ -68,6 +76,9 @@ public:
   void invertDisplay(bool i);
   void setContrast(uint8_t contrastlevel);
   void drawPixel(int16_t x, int16_t y, uint16_t color);
+  void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color);
+  void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color);
+  void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
   bool getPixel(int16_t x, int16_t y);
   uint8_t *getBuffer(void);
 
@@ -76,6 +87,9 @@ public:
 
 protected:
   bool _init(uint8_t i2caddr = 0x3C, bool reset = true);
+  bool nextDirtySpan(int16_t *band, int16_t *x1, int16_t *y1, int16_t *x2,
+                     int16_t *y2);
+  void clearDirtySpans(void);
 
   Adafruit_SPIDevice *spi_dev = NULL; ///< The SPI interface BusIO device
   Adafruit_I2CDevice *i2c_dev = NULL; ///< The I2C interface BusIO device
@@ -87,6 +101,8 @@ protected:
       window_y1,     ///< Dirty tracking window minimum y
       window_x2,     ///< Dirty tracking window maximum x
       window_y2;     ///< Dirty tracking window maximum y
+  int16_t *span_x1 = NULL, ///< Per row (4 bpp) or page (1 bpp) dirty min x
+      *span_x2 = NULL;     ///< Per row (4 bpp) or page (1 bpp) dirty max x
 
   int dcPin,  ///< The Arduino pin connected to D/C (for SPI)
       csPin,  ///< The Arduino pin connected to CS (for SPI)
@@ -94,6 +110,12 @@ protected:
 
   uint8_t _bpp = 1; ///< Bits per pixel color for this display
 private:
+  void markSpans(int16_t x, int16_t y, int16_t w, int16_t h);
+  int16_t bands(void) const { return (_bpp == 1) ? (HEIGHT + 7) / 8 : HEIGHT; }
+  int16_t bandBytes(int16_t x1, int16_t x2) const {
+    return (_bpp == 1) ? x2 - x1 + 1 : (x2 >> 1) - (x1 >> 1) + 1;
+  }
+
   TwoWire *_theWire = NULL; ///< The underlying hardware I2C
 };
 
@@ -952,7 +952,8 @@ void Adafruit_SPITFT::endWrite(void) {
     @param  color  16-bit pixel color in '565' RGB format.
 */
 void Adafruit_SPITFT::writePixel(int16_t x, int16_t y, uint16_t color) {
-  if ((x >= 0) && (x < _width) && (y >= 0) && (y < _height)) {
+  if ((x >= 0) && (x < _width) && (y >= 0) && (y < _height) &&
+      !clipped(x, y)) {
     setAddrWindow(x, y, 1, 1);
     SPI_WRITE16(color);
   }
@@ -1543,35 +1544,37 @@ void Adafruit_SPITFT::writeColor(uint16_t color, uint32_t len) {
 */
 void Adafruit_SPITFT::writeFillRect(int16_t x, int16_t y, int16_t w, int16_t h,
                                     uint16_t color) {
+  // Right and bottom edges of the visible area (display or clip rect)
+  int16_t xe = min(_width, clip_x2), ye = min(_height, clip_y2);
   if (w && h) {   // Nonzero width and height?
     if (w < 0) {  // If negative width...
       x += w + 1; //   Move X to left edge
       w = -w;     //   Use positive width
     }
-    if (x < _width) { // Not off right
-      if (h < 0) {    // If negative height...
-        y += h + 1;   //   Move Y to top edge
-        h = -h;       //   Use positive height
+    if (x < xe) {   // Not off right
+      if (h < 0) {  // If negative height...
+        y += h + 1; //   Move Y to top edge
+        h = -h;     //   Use positive height
       }
-      if (y < _height) { // Not off bottom
+      if (y < ye) { // Not off bottom
         int16_t x2 = x + w - 1;
-        if (x2 >= 0) { // Not off left
+        if (x2 >= clip_x1) { // Not off left
           int16_t y2 = y + h - 1;
-          if (y2 >= 0) { // Not off top
+          if (y2 >= clip_y1) { // Not off top
             // Rectangle partly or fully overlaps screen
-            if (x < 0) {
-              x = 0;
-              w = x2 + 1;
+            if (x < clip_x1) {
+              x = clip_x1;
+              w = x2 - x + 1;
             } // Clip left
-            if (y < 0) {
-              y = 0;
-              h = y2 + 1;
+            if (y < clip_y1) {
+              y = clip_y1;
+              h = y2 - y + 1;
             } // Clip top
-            if (x2 >= _width) {
-              w = _width - x;
+            if (x2 >= xe) {
+              w = xe - x;
             } // Clip right
-            if (y2 >= _height) {
-              h = _height - y;
+            if (y2 >= ye) {
+              h = ye - y;
             } // Clip bottom
             writeFillRectPreclipped(x, y, w, h, color);
           }
@@ -1595,21 +1598,23 @@ void Adafruit_SPITFT::writeFillRect(int16_t x, int16_t y, int16_t w, int16_t h,
 */
 void inline Adafruit_SPITFT::writeFastHLine(int16_t x, int16_t y, int16_t w,
                                             uint16_t color) {
-  if ((y >= 0) && (y < _height) && w) { // Y on screen, nonzero width
-    if (w < 0) {                        // If negative width...
-      x += w + 1;                       //   Move X to left edge
-      w = -w;                           //   Use positive width
+  int16_t xe = min(_width, clip_x2); // Visible right edge
+  // Y on screen and within the clip rect, nonzero width?
+  if ((y >= clip_y1) && (y < min(_height, clip_y2)) && w) {
+    if (w < 0) {  // If negative width...
+      x += w + 1; //   Move X to left edge
+      w = -w;     //   Use positive width
     }
-    if (x < _width) { // Not off right
+    if (x < xe) { // Not off right
       int16_t x2 = x + w - 1;
-      if (x2 >= 0) { // Not off left
+      if (x2 >= clip_x1) { // Not off left
         // Line partly or fully overlaps screen
-        if (x < 0) {
-          x = 0;
-          w = x2 + 1;
+        if (x < clip_x1) {
+          x = clip_x1;
+          w = x2 - x + 1;
         } // Clip left
-        if (x2 >= _width) {
-          w = _width - x;
+        if (x2 >= xe) {
+          w = xe - x;
         } // Clip right
         writeFillRectPreclipped(x, y, w, 1, color);
       }
@@ -1631,21 +1636,23 @@ void inline Adafruit_SPITFT::writeFastHLine(int16_t x, int16_t y, int16_t w,
 */
 void inline Adafruit_SPITFT::writeFastVLine(int16_t x, int16_t y, int16_t h,
                                             uint16_t color) {
-  if ((x >= 0) && (x < _width) && h) { // X on screen, nonzero height
-    if (h < 0) {                       // If negative height...
-      y += h + 1;                      //   Move Y to top edge
-      h = -h;                          //   Use positive height
+  int16_t ye = min(_height, clip_y2); // Visible bottom edge
+  // X on screen and within the clip rect, nonzero height?
+  if ((x >= clip_x1) && (x < min(_width, clip_x2)) && h) {
+    if (h < 0) {  // If negative height...
+      y += h + 1; //   Move Y to top edge
+      h = -h;     //   Use positive height
     }
-    if (y < _height) { // Not off bottom
+    if (y < ye) { // Not off bottom
       int16_t y2 = y + h - 1;
-      if (y2 >= 0) { // Not off top
+      if (y2 >= clip_y1) { // Not off top
         // Line partly or fully overlaps screen
-        if (y < 0) {
-          y = 0;
-          h = y2 + 1;
+        if (y < clip_y1) {
+          y = clip_y1;
+          h = y2 - y + 1;
         } // Clip top
-        if (y2 >= _height) {
-          h = _height - y;
+        if (y2 >= ye) {
+          h = ye - y;
         } // Clip bottom
         writeFillRectPreclipped(x, y, 1, h, color);
       }
@@ -1699,7 +1706,8 @@ inline void Adafruit_SPITFT::writeFillRectPreclipped(int16_t x, int16_t y,
 */
 void Adafruit_SPITFT::drawPixel(int16_t x, int16_t y, uint16_t color) {
   // Clip first...
-  if ((x >= 0) && (x < _width) && (y >= 0) && (y < _height)) {
+  if ((x >= 0) && (x < _width) && (y >= 0) && (y < _height) &&
+      !clipped(x, y)) {
     // THEN set up transaction (if needed) and draw...
     startWrite();
     setAddrWindow(x, y, 1, 1);
@@ -1729,35 +1737,37 @@ void Adafruit_SPITFT::drawPixel(int16_t x, int16_t y, uint16_t color) {
 */
 void Adafruit_SPITFT::fillRect(int16_t x, int16_t y, int16_t w, int16_t h,
                                uint16_t color) {
+  // Right and bottom edges of the visible area (display or clip rect)
+  int16_t xe = min(_width, clip_x2), ye = min(_height, clip_y2);
   if (w && h) {   // Nonzero width and height?
     if (w < 0) {  // If negative width...
       x += w + 1; //   Move X to left edge
       w = -w;     //   Use positive width
     }
-    if (x < _width) { // Not off right
-      if (h < 0) {    // If negative height...
-        y += h + 1;   //   Move Y to top edge
-        h = -h;       //   Use positive height
+    if (x < xe) {   // Not off right
+      if (h < 0) {  // If negative height...
+        y += h + 1; //   Move Y to top edge
+        h = -h;     //   Use positive height
       }
-      if (y < _height) { // Not off bottom
+      if (y < ye) { // Not off bottom
         int16_t x2 = x + w - 1;
-        if (x2 >= 0) { // Not off left
+        if (x2 >= clip_x1) { // Not off left
           int16_t y2 = y + h - 1;
-          if (y2 >= 0) { // Not off top
+          if (y2 >= clip_y1) { // Not off top
             // Rectangle partly or fully overlaps screen
-            if (x < 0) {
-              x = 0;
-              w = x2 + 1;
+            if (x < clip_x1) {
+              x = clip_x1;
+              w = x2 - x + 1;
             } // Clip left
-            if (y < 0) {
-              y = 0;
-              h = y2 + 1;
+            if (y < clip_y1) {
+              y = clip_y1;
+              h = y2 - y + 1;
             } // Clip top
-            if (x2 >= _width) {
-              w = _width - x;
+            if (x2 >= xe) {
+              w = xe - x;
             } // Clip right
-            if (y2 >= _height) {
-              h = _height - y;
+            if (y2 >= ye) {
+              h = ye - y;
             } // Clip bottom
             startWrite();
             writeFillRectPreclipped(x, y, w, h, color);
@@ -1787,21 +1797,23 @@ void Adafruit_SPITFT::fillRect(int16_t x, int16_t y, int16_t w, int16_t h,
 */
 void Adafruit_SPITFT::drawFastHLine(int16_t x, int16_t y, int16_t w,
                                     uint16_t color) {
-  if ((y >= 0) && (y < _height) && w) { // Y on screen, nonzero width
-    if (w < 0) {                        // If negative width...
-      x += w + 1;                       //   Move X to left edge
-      w = -w;                           //   Use positive width
+  int16_t xe = min(_width, clip_x2); // Visible right edge
+  // Y on screen and within the clip rect, nonzero width?
+  if ((y >= clip_y1) && (y < min(_height, clip_y2)) && w) {
+    if (w < 0) {  // If negative width...
+      x += w + 1; //   Move X to left edge
+      w = -w;     //   Use positive width
     }
-    if (x < _width) { // Not off right
+    if (x < xe) { // Not off right
       int16_t x2 = x + w - 1;
-      if (x2 >= 0) { // Not off left
+      if (x2 >= clip_x1) { // Not off left
         // Line partly or fully overlaps screen
-        if (x < 0) {
-          x = 0;
-          w = x2 + 1;
+        if (x < clip_x1) {
+          x = clip_x1;
+          w = x2 - x + 1;
         } // Clip left
-        if (x2 >= _width) {
-          w = _width - x;
+        if (x2 >= xe) {
+          w = xe - x;
         } // Clip right
         startWrite();
         writeFillRectPreclipped(x, y, w, 1, color);
@@ -1828,21 +1840,23 @@ void Adafruit_SPITFT::drawFastHLine(int16_t x, int16_t y, int16_t w,
 */
 void Adafruit_SPITFT::drawFastVLine(int16_t x, int16_t y, int16_t h,
                                     uint16_t color) {
-  if ((x >= 0) && (x < _width) && h) { // X on screen, nonzero height
-    if (h < 0) {                       // If negative height...
-      y += h + 1;                      //   Move Y to top edge
-      h = -h;                          //   Use positive height
+  int16_t ye = min(_height, clip_y2); // Visible bottom edge
+  // X on screen and within the clip rect, nonzero height?
+  if ((x >= clip_x1) && (x < min(_width, clip_x2)) && h) {
+    if (h < 0) {  // If negative height...
+      y += h + 1; //   Move Y to top edge
+      h = -h;     //   Use positive height
     }
-    if (y < _height) { // Not off bottom
+    if (y < ye) { // Not off bottom
       int16_t y2 = y + h - 1;
-      if (y2 >= 0) { // Not off top
+      if (y2 >= clip_y1) { // Not off top
         // Line partly or fully overlaps screen
-        if (y < 0) {
-          y = 0;
-          h = y2 + 1;
+        if (y < clip_y1) {
+          y = clip_y1;
+          h = y2 - y + 1;
         } // Clip top
-        if (y2 >= _height) {
-          h = _height - y;
+        if (y2 >= ye) {
+          h = ye - y;
         } // Clip bottom
         startWrite();
         writeFillRectPreclipped(x, y, 1, h, color);
@@ -1884,29 +1898,30 @@ void Adafruit_SPITFT::pushColor(uint16_t color) {
 void Adafruit_SPITFT::drawRGBBitmap(int16_t x, int16_t y, uint16_t *pcolors,
                                     int16_t w, int16_t h) {
 
-  int16_t x2, y2;                 // Lower-right coord
-  if ((x >= _width) ||            // Off-edge right
-      (y >= _height) ||           // " top
-      ((x2 = (x + w - 1)) < 0) || // " left
-      ((y2 = (y + h - 1)) < 0))
+  int16_t xe = min(_width, clip_x2), ye = min(_height, clip_y2);
+  int16_t x2, y2;                       // Lower-right coord
+  if ((x >= xe) ||                      // Off-edge right
+      (y >= ye) ||                      // " top
+      ((x2 = (x + w - 1)) < clip_x1) || // " left
+      ((y2 = (y + h - 1)) < clip_y1))
     return; // " bottom
 
   int16_t bx1 = 0, by1 = 0, // Clipped top-left within bitmap
       saveW = w;            // Save original bitmap width value
-  if (x < 0) {              // Clip left
-    w += x;
-    bx1 = -x;
-    x = 0;
+  if (x < clip_x1) {        // Clip left
+    w -= clip_x1 - x;
+    bx1 = clip_x1 - x;
+    x = clip_x1;
   }
-  if (y < 0) { // Clip top
-    h += y;
-    by1 = -y;
-    y = 0;
+  if (y < clip_y1) { // Clip top
+    h -= clip_y1 - y;
+    by1 = clip_y1 - y;
+    y = clip_y1;
   }
-  if (x2 >= _width)
-    w = _width - x; // Clip right
-  if (y2 >= _height)
-    h = _height - y; // Clip bottom
+  if (x2 >= xe)
+    w = xe - x; // Clip right
+  if (y2 >= ye)
+    h = ye - y; // Clip bottom
 
   pcolors += by1 * saveW + bx1; // Offset bitmap ptr to clipped top-left
   startWrite();
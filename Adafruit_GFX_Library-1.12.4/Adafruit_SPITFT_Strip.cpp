@@ -0,0 +1,216 @@
+/*!
+ * @file Adafruit_SPITFT_Strip.cpp
+ *
+ * Strip-buffered rendering for Adafruit_SPITFT displays: drawing is
+ * recorded as a primitive list and rasterised one horizontal band at a
+ * time, so a full frame can be pushed without flicker from a few KB of
+ * RAM instead of a whole-screen framebuffer.
+ *
+ * BSD license, all text above must be included in any redistribution.
+ */
+
+#if !defined(__AVR_ATtiny85__) && !defined(__AVR_ATtiny84__)
+
+#include "Adafruit_SPITFT_Strip.h"
+
+#ifndef min
+#define min(a, b) (((a) < (b)) ? (a) : (b))
+#endif
+
+// GFXstrip16 --------------------------------------------------------------
+
+/**************************************************************************/
+/*!
+   @brief    Instantiate a band canvas for a screen of the given size. No
+             buffer is allocated; setBand() supplies one.
+    @param    w   Screen width, in pixels
+    @param    h   Screen height, in pixels
+*/
+/**************************************************************************/
+GFXstrip16::GFXstrip16(uint16_t w, uint16_t h) : Adafruit_GFX(w, h) {}
+
+/**************************************************************************/
+/*!
+   @brief    Point the canvas at a band of the screen and fill it.
+    @param    buf     Raster for the band, width() x h pixels
+    @param    y       Screen row of the band's first row
+    @param    h       Rows in the band
+    @param    color   16-bit 5-6-5 color to fill the band with
+*/
+/**************************************************************************/
+void GFXstrip16::setBand(uint16_t *buf, int16_t y, int16_t h,
+                         uint16_t color) {
+  buffer = buf;
+  band_y = y;
+  setClipRect(0, y, _width, h);
+  clearDirty();
+  color = (color >> 8) | (color << 8);
+  for (uint32_t i = 0, n = (uint32_t)_width * h; i < n; i++)
+    buf[i] = color;
+}
+
+/**************************************************************************/
+/*!
+   @brief    Draw a pixel, if it falls within the band.
+    @param    x       Screen x coordinate
+    @param    y       Screen y coordinate
+    @param    color   16-bit 5-6-5 color to draw pixel with
+*/
+/**************************************************************************/
+void GFXstrip16::drawPixel(int16_t x, int16_t y, uint16_t color) {
+  if ((x < 0) || (x >= _width) || clipped(x, y))
+    return;
+  buffer[(y - band_y) * _width + x] = (color >> 8) | (color << 8);
+}
+
+/**************************************************************************/
+/*!
+   @brief    Draw the part of a vertical line that falls within the band.
+    @param    x       Screen x coordinate
+    @param    y       Top-most screen y coordinate
+    @param    h       Height in pixels
+    @param    color   16-bit 5-6-5 color to draw line with
+*/
+/**************************************************************************/
+void GFXstrip16::drawFastVLine(int16_t x, int16_t y, int16_t h,
+                               uint16_t color) {
+  fillRect(x, y, 1, h, color);
+}
+
+/**************************************************************************/
+/*!
+   @brief    Draw the part of a horizontal line that falls within the band.
+    @param    x       Left-most screen x coordinate
+    @param    y       Screen y coordinate
+    @param    w       Width in pixels
+    @param    color   16-bit 5-6-5 color to draw line with
+*/
+/**************************************************************************/
+void GFXstrip16::drawFastHLine(int16_t x, int16_t y, int16_t w,
+                               uint16_t color) {
+  fillRect(x, y, w, 1, color);
+}
+
+/**************************************************************************/
+/*!
+   @brief    Fill the part of a rectangle that falls within the band.
+    @param    x       Left-most screen x coordinate
+    @param    y       Top-most screen y coordinate
+    @param    w       Width in pixels; negative widths extend left from x
+    @param    h       Height in pixels; negative heights extend up from y
+    @param    color   16-bit 5-6-5 color to fill with
+*/
+/**************************************************************************/
+void GFXstrip16::fillRect(int16_t x, int16_t y, int16_t w, int16_t h,
+                          uint16_t color) {
+  if (w < 0) { // Convert negative sizes to positive equivalent
+    w = -w;
+    x -= w - 1;
+  }
+  if (h < 0) {
+    h = -h;
+    y -= h - 1;
+  }
+  int16_t xe = min(_width, clip_x2), ye = min(_height, clip_y2);
+  if (x < clip_x1) {
+    w -= clip_x1 - x;
+    x = clip_x1;
+  }
+  if (y < clip_y1) {
+    h -= clip_y1 - y;
+    y = clip_y1;
+  }
+  if (x + w > xe)
+    w = xe - x;
+  if (y + h > ye)
+    h = ye - y;
+  if ((w <= 0) || (h <= 0))
+    return;
+
+  color = (color >> 8) | (color << 8);
+  uint16_t *row = &buffer[(y - band_y) * _width + x];
+  for (; h--; row += _width) {
+    for (int16_t i = 0; i < w; i++)
+      row[i] = color;
+  }
+}
+
+// Adafruit_SPITFT_Strip ---------------------------------------------------
+
+/**************************************************************************/
+/*!
+   @brief    Instantiate a strip renderer. Call begin() before drawing.
+    @param    tft       Display to render to. Its rotation must already
+                        give it a width() and height() of w and h.
+    @param    w         Display width, in pixels
+    @param    h         Display height, in pixels
+    @param    strip_h   Rows per strip. Two strips of w x strip_h pixels
+                        are allocated, 4 * w * strip_h bytes in all.
+    @param    ops       Initial capacity of the primitive list; it grows
+                        as needed.
+*/
+/**************************************************************************/
+Adafruit_SPITFT_Strip::Adafruit_SPITFT_Strip(Adafruit_SPITFT *tft, uint16_t w,
+                                             uint16_t h, uint8_t strip_h,
+                                             uint16_t ops)
+    : GFXrecorder(w, h, ops), tft(tft), strip(w, h),
+      band_h(strip_h ? strip_h : 1) {}
+
+/**************************************************************************/
+/*!
+   @brief    Delete the strip renderer and free its buffers.
+*/
+/**************************************************************************/
+Adafruit_SPITFT_Strip::~Adafruit_SPITFT_Strip(void) {
+  free(band[0]);
+  free(band[1]);
+}
+
+/**************************************************************************/
+/*!
+   @brief    Allocate the primitive list and strip buffers.
+    @returns  true on success, false if out of memory
+*/
+/**************************************************************************/
+bool Adafruit_SPITFT_Strip::begin(void) {
+  uint32_t bytes = (uint32_t)WIDTH * band_h * 2;
+  if (!beginOps())
+    return false;
+  if ((!band[0]) && !(band[0] = (uint16_t *)malloc(bytes)))
+    return false;
+  if ((!band[1]) && !(band[1] = (uint16_t *)malloc(bytes)))
+    return false;
+  clearDisplay();
+  return true;
+}
+
+/**************************************************************************/
+/*!
+   @brief    Render the recorded frame strip by strip and send it to the
+             display as one continuous address window. Each strip is sent
+             without blocking, so where writePixels() runs in the
+             background the next strip is drawn while the last one is on
+             the wire. The list is kept, so later drawing adds to it as it
+             would to a framebuffer.
+*/
+/**************************************************************************/
+void Adafruit_SPITFT_Strip::display(void) {
+  if (!band[1])
+    return;
+  tft->startWrite();
+  tft->setAddrWindow(0, 0, _width, _height);
+  uint8_t b = 0;
+  for (int16_t y = 0; y < _height; y += band_h) {
+    int16_t h = min((int16_t)band_h, (int16_t)(_height - y));
+    // Two strips back, this buffer's transfer had to finish before the
+    // last writePixels() could start, so it is free to draw into.
+    strip.setBand(band[b], y, h, background);
+    replay(strip);
+    tft->writePixels(band[b], (uint32_t)_width * h, false, true);
+    b ^= 1;
+  }
+  tft->dmaWait();
+  tft->endWrite();
+}
+
+#endif // end __AVR_ATtiny85__ __AVR_ATtiny84__
@@ -0,0 +1,83 @@
+/*!
+ * @file Adafruit_SPITFT_Strip.h
+ *
+ * Strip-buffered rendering for Adafruit_SPITFT displays.
+ *
+ * A full RGB565 framebuffer for a 240x240 panel is 115 KB, and drawing
+ * primitive-by-primitive straight to the panel flickers whenever a frame
+ * clears the screen and overdraws. Adafruit_SPITFT_Strip sits in between:
+ * drawing calls are recorded as a list of primitives, and display()
+ * rasterises that list into one horizontal band (strip) at a time and
+ * pushes each band with writePixels(). Two band buffers are used, so that
+ * on targets where writePixels() can run in the background the next band
+ * is drawn while the previous one is still being sent.
+ *
+ * The API mirrors the monochrome OLED drivers (clearDisplay(), draw...,
+ * display()), so code written against those (e.g. RoboEyes) can target a
+ * colour TFT unchanged, given RGB565 colours.
+ *
+ * BSD license, all text above must be included in any redistribution.
+ */
+
+#ifndef _ADAFRUIT_SPITFT_STRIP_H_
+#define _ADAFRUIT_SPITFT_STRIP_H_
+
+#if !defined(__AVR_ATtiny85__) && !defined(__AVR_ATtiny84__)
+
+#include "Adafruit_GFX_Direct.h"
+#include "Adafruit_GFX_Recorder.h"
+#include "Adafruit_SPITFT.h"
+
+/// A GFXcanvas16-style canvas covering one horizontal band of a larger
+/// screen. Drawing uses whole-screen coordinates; the band is the clip
+/// rect, so primitives outside it are rejected whole. Pixels are stored
+/// big-endian, ready for writePixels(..., bigEndian = true).
+class GFXstrip16 : public Adafruit_GFX {
+public:
+  GFXstrip16(uint16_t w, uint16_t h);
+  void setBand(uint16_t *buf, int16_t y, int16_t h, uint16_t color);
+  void drawPixel(int16_t x, int16_t y, uint16_t color);
+  void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color);
+  void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color);
+  void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+
+private:
+  uint16_t *buffer = NULL; ///< Band raster, _width x band height
+  int16_t band_y = 0;      ///< Screen row of the band's first row
+};
+
+/// Records drawing for an Adafruit_SPITFT and renders it in strips
+class Adafruit_SPITFT_Strip : public GFXrecorder {
+public:
+  Adafruit_SPITFT_Strip(Adafruit_SPITFT *tft, uint16_t w, uint16_t h,
+                        uint8_t strip_h = 16, uint16_t ops = 128);
+  ~Adafruit_SPITFT_Strip(void);
+
+  bool begin(void);
+  void display(void);
+
+private:
+  Adafruit_SPITFT *tft;             ///< Display the strips are sent to
+  GFXstrip16 strip;                 ///< Canvas the list is replayed into
+  uint16_t *band[2] = {NULL, NULL}; ///< Double-buffered strip rasters
+  uint8_t band_h;                   ///< Rows per strip
+};
+
+/// Adafruit_GFX_Direct for a strip recorder: each primitive is recorded
+/// once, rather than broken into spans on the way in.
+template <>
+class Adafruit_GFX_Direct<Adafruit_SPITFT_Strip>
+    : public GFXrecorderDirect<Adafruit_SPITFT_Strip> {
+public:
+  /**********************************************************************/
+  /*!
+    @brief  Wrap a strip recorder for statically dispatched drawing
+    @param  display  Recorder object; must outlive this wrapper
+  */
+  /**********************************************************************/
+  Adafruit_GFX_Direct(Adafruit_SPITFT_Strip &display)
+      : GFXrecorderDirect<Adafruit_SPITFT_Strip>(display) {}
+};
+
+#endif // end __AVR_ATtiny85__ __AVR_ATtiny84__
+#endif // _ADAFRUIT_SPITFT_STRIP_H_
@@ -8,6 +8,10 @@ fonts to be used with the Adafruit_GFX Arduino library.
 For UNIX-like systems.  Outputs to stdout; redirect to header file, e.g.:
   ./fontconvert ~/Library/Fonts/FreeSans.ttf 18 > FreeSans18pt7b.h
 
+Pass -r ahead of the filename to emit a run-length encoded GFXfontRLE
+(use with setFontRLE()).  This usually saves 30-50% of bitmap flash at
+18 points and up; small faces are better left uncompressed.
+
 REQUIRES FREETYPE LIBRARY.  www.freetype.org
 
 Currently this only extracts the printable 7-bit ASCII chars of a font.
@@ -22,6 +26,7 @@ See notes at end for glyph nomenclature & other tidbits.
 #include <ft2build.h>
 #include <stdint.h>
 #include <stdio.h>
+#include <string.h>
 #include FT_GLYPH_H
 #include FT_MODULE_H
 #include FT_TRUETYPE_DRIVER_H
@@ -29,29 +34,66 @@ See notes at end for glyph nomenclature & other tidbits.
 
 #define DPI 141 // Approximate res. of Adafruit 2.8" TFT
 
+// Write one hexadecimal byte to the bitmap table, formatted 12 per line
+void enbyte(uint8_t sum) {
+  static uint8_t row = 0, firstCall = 1;
+  if (!firstCall) {    // Format output table nicely
+    if (++row >= 12) { // Last entry on line?
+      printf(",\n  "); //   Newline format output
+      row = 0;         //   Reset row counter
+    } else {           // Not end of line
+      printf(", ");    //   Simple comma delim
+    }
+  }
+  printf("0x%02X", sum); // Write byte value
+  firstCall = 0;         // Formatting flag
+}
+
 // Accumulate bits for output, with periodic hexadecimal byte write
 void enbit(uint8_t value) {
-  static uint8_t row = 0, sum = 0, bit = 0x80, firstCall = 1;
+  static uint8_t sum = 0, bit = 0x80;
   if (value)
-    sum |= bit;          // Set bit if needed
-  if (!(bit >>= 1)) {    // Advance to next bit, end of byte reached?
-    if (!firstCall) {    // Format output table nicely
-      if (++row >= 12) { // Last entry on line?
-        printf(",\n  "); //   Newline format output
-        row = 0;         //   Reset row counter
-      } else {           // Not end of line
-        printf(", ");    //   Simple comma delim
-      }
-    }
-    printf("0x%02X", sum); // Write byte value
-    sum = 0;               // Clear for next byte
-    bit = 0x80;            // Reset bit counter
-    firstCall = 0;         // Formatting flag
+    sum |= bit;       // Set bit if needed
+  if (!(bit >>= 1)) { // Advance to next bit, end of byte reached?
+    enbyte(sum);      // Write byte value
+    sum = 0;          // Clear for next byte
+    bit = 0x80;       // Reset bit counter
+  }
+}
+
+// Accumulate RLE nibbles for output, high nibble first. Returns the number
+// of bytes written (0 or 1). Pass a value > 15 to flush a pending nibble.
+int ennibble(uint8_t value) {
+  static uint8_t sum = 0, half = 0;
+  if (value > 15) { // Flush: pad last byte of glyph with a zero nibble
+    if (!half)
+      return 0;
+    value = 0;
+  }
+  if (!half) {
+    sum = value << 4;
+    half = 1;
+    return 0;
   }
+  enbyte(sum | value);
+  half = 0;
+  return 1;
+}
+
+// Emit one run of 'len' pixels for the RLE format (see GFXfontRLE in
+// gfxfont.h). Runs of 15 or more use the no-toggle nibble 15 as needed.
+int enrun(int len) {
+  int bytes = 0;
+  while (len >= 15) {
+    bytes += ennibble(15);
+    len -= 15;
+  }
+  return bytes + ennibble(len);
 }
 
 int main(int argc, char *argv[]) {
   int i, j, err, size, first = ' ', last = '~', bitmapOffset = 0, x, y, byte;
+  int rle = 0, rawBytes = 0;
   char *fontName, c, *ptr;
   FT_Library library;
   FT_Face face;
@@ -62,14 +104,22 @@ int main(int argc, char *argv[]) {
   uint8_t bit;
 
   // Parse command line.  Valid syntaxes are:
-  //   fontconvert [filename] [size]
-  //   fontconvert [filename] [size] [last char]
-  //   fontconvert [filename] [size] [first char] [last char]
+  //   fontconvert [-r] [filename] [size]
+  //   fontconvert [-r] [filename] [size] [last char]
+  //   fontconvert [-r] [filename] [size] [first char] [last char]
   // Unless overridden, default first and last chars are
-  // ' ' (space) and '~', respectively
+  // ' ' (space) and '~', respectively.  -r selects RLE glyph bitmaps.
+
+  if ((argc > 1) && !strcmp(argv[1], "-r")) {
+    rle = 1;
+    argv[1] = argv[0]; // Drop the flag, positional args parse as before
+    argv++;
+    argc--;
+  }
 
   if (argc < 3) {
-    fprintf(stderr, "Usage: %s fontfile size [first] [last]\n", argv[0]);
+    fprintf(stderr, "Usage: %s [-r] fontfile size [first] [last]\n",
+            argv[0]);
     return 1;
   }
 
@@ -109,7 +159,7 @@ int main(int argc, char *argv[]) {
     ptr = &fontName[strlen(fontName)]; // If none, append
   // Insert font size and 7/8 bit.  fontName was alloc'd w/extra
   // space to allow this, we're not sprintfing into Forbidden Zone.
-  sprintf(ptr, "%dpt%db", size, (last > 127) ? 8 : 7);
+  sprintf(ptr, "%dpt%db%s", size, (last > 127) ? 8 : 7, rle ? "RLE" : "");
   // Space and punctuation chars in name replaced w/ underscores.
   for (i = 0; (c = fontName[i]); i++) {
     if (isspace(c) || ispunct(c))
@@ -184,22 +234,46 @@ int main(int argc, char *argv[]) {
     table[j].xOffset = g->left;
     table[j].yOffset = 1 - g->top;
 
-    for (y = 0; y < bitmap->rows; y++) {
-      for (x = 0; x < bitmap->width; x++) {
-        byte = x / 8;
-        bit = 0x80 >> (x & 7);
-        enbit(bitmap->buffer[y * bitmap->pitch + byte] & bit);
+    rawBytes += (bitmap->width * bitmap->rows + 7) / 8;
+
+    if (rle) {
+      // Alternating off/on runs in raster order, spanning scanlines,
+      // always starting with an 'off' run (possibly zero-length).
+      int run = 0, on = 0;
+      for (y = 0; y < bitmap->rows; y++) {
+        for (x = 0; x < bitmap->width; x++) {
+          byte = x / 8;
+          bit = 0x80 >> (x & 7);
+          if (!(bitmap->buffer[y * bitmap->pitch + byte] & bit) != !on) {
+            bitmapOffset += enrun(run); // Color change, close current run
+            run = 0;
+            on = !on;
+          }
+          run++;
+        }
+      }
+      if (bitmap->width * bitmap->rows) {
+        bitmapOffset += enrun(run);
+        bitmapOffset += ennibble(16); // Next glyph starts on a byte boundary
+      }
+    } else {
+      for (y = 0; y < bitmap->rows; y++) {
+        for (x = 0; x < bitmap->width; x++) {
+          byte = x / 8;
+          bit = 0x80 >> (x & 7);
+          enbit(bitmap->buffer[y * bitmap->pitch + byte] & bit);
+        }
       }
-    }
 
-    // Pad end of char bitmap to next byte boundary if needed
-    int n = (bitmap->width * bitmap->rows) & 7;
-    if (n) {     // Pixel count not an even multiple of 8?
-      n = 8 - n; // # bits to next multiple
-      while (n--)
-        enbit(0);
+      // Pad end of char bitmap to next byte boundary if needed
+      int n = (bitmap->width * bitmap->rows) & 7;
+      if (n) {     // Pixel count not an even multiple of 8?
+        n = 8 - n; // # bits to next multiple
+        while (n--)
+          enbit(0);
+      }
+      bitmapOffset += (bitmap->width * bitmap->rows + 7) / 8;
     }
-    bitmapOffset += (bitmap->width * bitmap->rows + 7) / 8;
 
     FT_Done_Glyph(glyph);
   }
@@ -226,17 +300,26 @@ int main(int argc, char *argv[]) {
   printf("\n\n");
 
   // Output font structure
-  printf("const GFXfont %s PROGMEM = {\n", fontName);
+  if (rle) {
+    printf("const GFXfontRLE %s PROGMEM = {{\n", fontName);
+  } else {
+    printf("const GFXfont %s PROGMEM = {\n", fontName);
+  }
   printf("  (uint8_t  *)%sBitmaps,\n", fontName);
   printf("  (GFXglyph *)%sGlyphs,\n", fontName);
   if (face->size->metrics.height == 0) {
     // No face height info, assume fixed width and get from a glyph.
-    printf("  0x%02X, 0x%02X, %d };\n\n", first, last, table[0].height);
+    printf("  0x%02X, 0x%02X, %d }%s;\n\n", first, last, table[0].height,
+           rle ? "}" : "");
   } else {
-    printf("  0x%02X, 0x%02X, %ld };\n\n", first, last,
-           face->size->metrics.height >> 6);
+    printf("  0x%02X, 0x%02X, %ld }%s;\n\n", first, last,
+           face->size->metrics.height >> 6, rle ? "}" : "");
   }
   printf("// Approx. %d bytes\n", bitmapOffset + (last - first + 1) * 7 + 7);
+  if (rle) {
+    printf("// RLE bitmaps %d bytes, uncompressed %d bytes\n", bitmapOffset,
+           rawBytes);
+  }
   // Size estimate is based on AVR struct and pointer sizes;
   // actual size may vary.
 
@@ -26,4 +26,14 @@ typedef struct {
   uint8_t yAdvance; ///< Newline distance (y axis)
 } GFXfont;
 
+/// Font whose glyph bitmaps are run-length encoded (fontconvert -r).
+/// Each glyph's bitmapOffset points at a nibble stream, high nibble first,
+/// starting on a byte boundary. Runs alternate off/on, beginning with an
+/// 'off' run; a nibble of 0-14 is a run of that many pixels followed by a
+/// color toggle, 15 is a run of 15 pixels with no toggle. Runs continue
+/// across scanlines until width * height pixels have been produced.
+typedef struct {
+  GFXfont font; ///< Metrics, glyph table and RLE glyph streams
+} GFXfontRLE;
+
 #endif // _GFXFONT_H_
@@ -26,10 +26,14 @@
 #ifndef _FLUXGARAGE_ROBOEYES_H
 #define _FLUXGARAGE_ROBOEYES_H
 
+#ifdef ROBOEYES_DIRECT
+#include <Adafruit_GFX_Direct.h>
+#endif
+
 
 // Display colors
-uint8_t BGCOLOR = 0; // background and overlays
-uint8_t MAINCOLOR = 1; // drawings
+uint16_t BGCOLOR = 0; // background and overlays
+uint16_t MAINCOLOR = 1; // drawings
 
 // For mood type switch
 #define DEFAULT 0
@@ -66,6 +70,16 @@ public:
 
 // Reference to Adafruit display object
 AdafruitDisplay *display;
+// What the eyes are drawn through: the display's own (virtual) GFX calls,
+// or, with ROBOEYES_DIRECT defined before this header is included,
+// primitives bound to the display type at compile time so the span loops
+// inline (see Adafruit_GFX_Direct.h). The direct path is larger and has
+// not been measured faster on the ESP32, so it is opt-in
+#ifdef ROBOEYES_DIRECT
+Adafruit_GFX_Direct<AdafruitDisplay> gfx;
+#else
+AdafruitDisplay &gfx;
+#endif
 
 // For general setup - screen size and max. frame rate
 int screenWidth = 128; // OLED display width, in pixels
@@ -160,6 +174,21 @@ bool vFlicker = 0;
 bool vFlickerAlternate = 0;
 byte vFlickerAmplitude = 10;
 
+// Hardware effects - done with display commands instead of redrawn pixels
+// where the display offers them (start line, contrast, invert, e.g. SH1106),
+// otherwise drawn in software or left out
+bool hwShake = 1; // vertical flicker by moving the display start line
+byte startLine = 0; // start line currently set on the display
+byte contrastDefault = 0xCF; // contrast the display was initialised with, read from it at begin() where it tells
+byte contrastSleepy = 0x08; // contrast to fade to while sleepy
+byte contrastCurrent = 0xCF;
+byte contrastTarget = 0xCF;
+byte contrastStep = 1; // contrast change per frame while fading
+bool flash = 0; // invert the picture for flashDuration
+bool flashInverted = 0; // display currently set to inverted by a flash
+unsigned long flashTimer = 0;
+int flashDuration = 120;
+
 // Animation - auto blinking
 bool autoblinker = 0; // activate auto blink animation
 int blinkInterval = 1; // basic interval between each blink in full seconds
@@ -318,7 +347,7 @@ bool eyeRollToggle = 1;
 //  GENERAL METHODS
 //*********************************************************************************************
 
-RoboEyes(AdafruitDisplay &disp) : display(&disp) {};
+RoboEyes(AdafruitDisplay &disp) : display(&disp), gfx(disp) {};
 
 // Startup RoboEyes with defined screen-width, screen-height and max. frames per second
 void begin(int width, int height, byte frameRate) {
@@ -329,6 +358,10 @@ void begin(int width, int height, byte frameRate) {
   eyeLheightCurrent = 1; // start with closed eyes
   eyeRheightCurrent = 1; // start with closed eyes
   setFramerate(frameRate); // calculate frame interval based on defined frameRate
+  byte level;
+  if(hwInitContrast(display, &level, 0)){
+    setContrastDefault(level); // e.g. lower on externally powered panels
+  }
 }
 
 void update(){
@@ -350,8 +383,8 @@ void setFramerate(byte fps){
 }
 
 // Set color values
-void setDisplayColors(uint8_t background, uint8_t main) {
-  BGCOLOR = background; // background and overlays, choose 0 for monochrome displays and 0x00 for grayscale displays such as SSD1322
+void setDisplayColors(uint16_t background, uint16_t main) {
+  BGCOLOR = background; // background and overlays, choose 0 for monochrome displays and 0x00 for grayscale displays such as SSD1322, or a 16-bit 5-6-5 color for colour TFTs
   MAINCOLOR = main; // drawings, choose 1 for monochrome displays and 0x0F for grayscale displays such as SSD1322 (0x0F = maximum brightness)
 }
 
@@ -570,9 +603,32 @@ void setShimmer(bool shimmerBit) {
 }
 
 void setSleepy(bool sleepyBit) {
+  if(sleepyBit != sleepy){
+    fadeContrast(sleepyBit ? contrastSleepy : contrastDefault, sleepyBit ? 1500 : 500);
+  }
   sleepy = sleepyBit;
 }
 
+// Fade the display contrast to level over roughly duration milliseconds, one
+// contrast command per frame. Does nothing on displays without a contrast
+// command
+void fadeContrast(byte level, int duration) {
+  int frames = max(1, duration/frameInterval);
+  contrastTarget = level;
+  contrastStep = max(1, abs((int)level-(int)contrastCurrent)/frames);
+}
+
+// Set the contrast the display runs at when not dimmed (its init value)
+void setContrastDefault(byte level) {
+  contrastDefault = level;
+  contrastCurrent = contrastTarget = level;
+}
+
+// Use the display start line for vertical flicker where possible (default on)
+void setHardwareShake(bool shakeBit) {
+  hwShake = shakeBit;
+}
+
 void setDizzy(bool dizzyBit) {
   dizzy = dizzyBit;
   if(dizzy){
@@ -685,6 +741,13 @@ void anim_hearts() {
 void anim_eyeRoll() {
   eyeRolling = 1;
 }
+
+// Play flash animation - picture inverted for flashDuration, with the
+// display's invert command if it has one, else by swapping the colors
+void anim_flash() {
+  flash = 1;
+  flashTimer = millis();
+}
 //*********************************************************************************************
 //  PRE-CALCULATIONS AND ACTUAL DRAWINGS
 //*********************************************************************************************
@@ -803,14 +866,17 @@ void drawEyes(){
     hFlickerAlternate = !hFlickerAlternate;
   }
 
-  // Adding offsets for horizontal flickering/shivering
+  // Adding offsets for vertical flickering/shivering. With a start line
+  // register the whole picture is moved instead, so alternate frames draw
+  // the same pixels and only the start line command goes out
+  byte startLineNext = 0;
   if(vFlicker){
-    if(vFlickerAlternate) {
-      eyeLy += vFlickerAmplitude;
-      eyeRy += vFlickerAmplitude;
+    int dy = vFlickerAlternate ? vFlickerAmplitude : -vFlickerAmplitude;
+    if(hwShake && canShake(dy)) {
+      startLineNext = (64-dy) & 63;
     } else {
-      eyeLy -= vFlickerAmplitude;
-      eyeRy -= vFlickerAmplitude;
+      eyeLy += dy;
+      eyeRy += dy;
     }
     vFlickerAlternate = !vFlickerAlternate;
   }
@@ -822,14 +888,26 @@ void drawEyes(){
     spaceBetweenCurrent = 0;
   }
 
+  // Flash - invert in hardware if possible, else draw with swapped colors
+  if(flash && millis() >= flashTimer+flashDuration){
+    flash = 0;
+  }
+  bool flashSoftware = flash && !hasInvert(&AdafruitDisplay::invertDisplay);
+  if(flashSoftware){
+    uint16_t t = BGCOLOR; BGCOLOR = MAINCOLOR; MAINCOLOR = t;
+  }
+
   //// ACTUAL DRAWINGS ////
 
   display->clearDisplay(); // start with a blank screen
+  if(flashSoftware){
+    gfx.fillRect(0, 0, screenWidth, screenHeight, BGCOLOR);
+  }
 
   // Draw basic eye rectangles
-  display->fillRoundRect(eyeLx, eyeLy, eyeLwidthCurrent, eyeLheightCurrent, eyeLborderRadiusCurrent, MAINCOLOR); // left eye
+  gfx.fillRoundRect(eyeLx, eyeLy, eyeLwidthCurrent, eyeLheightCurrent, eyeLborderRadiusCurrent, MAINCOLOR); // left eye
   if (!cyclops){
-    display->fillRoundRect(eyeRx, eyeRy, eyeRwidthCurrent, eyeRheightCurrent, eyeRborderRadiusCurrent, MAINCOLOR); // right eye
+    gfx.fillRoundRect(eyeRx, eyeRy, eyeRwidthCurrent, eyeRheightCurrent, eyeRborderRadiusCurrent, MAINCOLOR); // right eye
   }
 
   // Prepare mood type transitions
@@ -840,30 +918,30 @@ void drawEyes(){
   // Draw tired top eyelids 
     eyelidsTiredHeight = (eyelidsTiredHeight + eyelidsTiredHeightNext)/2;
     if (!cyclops){
-      display->fillTriangle(eyeLx, eyeLy-1, eyeLx+eyeLwidthCurrent, eyeLy-1, eyeLx, eyeLy+eyelidsTiredHeight-1, BGCOLOR); // left eye 
-      display->fillTriangle(eyeRx, eyeRy-1, eyeRx+eyeRwidthCurrent, eyeRy-1, eyeRx+eyeRwidthCurrent, eyeRy+eyelidsTiredHeight-1, BGCOLOR); // right eye
+      gfx.fillTriangle(eyeLx, eyeLy-1, eyeLx+eyeLwidthCurrent, eyeLy-1, eyeLx, eyeLy+eyelidsTiredHeight-1, BGCOLOR); // left eye 
+      gfx.fillTriangle(eyeRx, eyeRy-1, eyeRx+eyeRwidthCurrent, eyeRy-1, eyeRx+eyeRwidthCurrent, eyeRy+eyelidsTiredHeight-1, BGCOLOR); // right eye
     } else {
       // Cyclops tired eyelids
-      display->fillTriangle(eyeLx, eyeLy-1, eyeLx+(eyeLwidthCurrent/2), eyeLy-1, eyeLx, eyeLy+eyelidsTiredHeight-1, BGCOLOR); // left eyelid half
-      display->fillTriangle(eyeLx+(eyeLwidthCurrent/2), eyeLy-1, eyeLx+eyeLwidthCurrent, eyeLy-1, eyeLx+eyeLwidthCurrent, eyeLy+eyelidsTiredHeight-1, BGCOLOR); // right eyelid half
+      gfx.fillTriangle(eyeLx, eyeLy-1, eyeLx+(eyeLwidthCurrent/2), eyeLy-1, eyeLx, eyeLy+eyelidsTiredHeight-1, BGCOLOR); // left eyelid half
+      gfx.fillTriangle(eyeLx+(eyeLwidthCurrent/2), eyeLy-1, eyeLx+eyeLwidthCurrent, eyeLy-1, eyeLx+eyeLwidthCurrent, eyeLy+eyelidsTiredHeight-1, BGCOLOR); // right eyelid half
     }
 
   // Draw angry top eyelids 
     eyelidsAngryHeight = (eyelidsAngryHeight + eyelidsAngryHeightNext)/2;
     if (!cyclops){ 
-      display->fillTriangle(eyeLx, eyeLy-1, eyeLx+eyeLwidthCurrent, eyeLy-1, eyeLx+eyeLwidthCurrent, eyeLy+eyelidsAngryHeight-1, BGCOLOR); // left eye
-      display->fillTriangle(eyeRx, eyeRy-1, eyeRx+eyeRwidthCurrent, eyeRy-1, eyeRx, eyeRy+eyelidsAngryHeight-1, BGCOLOR); // right eye
+      gfx.fillTriangle(eyeLx, eyeLy-1, eyeLx+eyeLwidthCurrent, eyeLy-1, eyeLx+eyeLwidthCurrent, eyeLy+eyelidsAngryHeight-1, BGCOLOR); // left eye
+      gfx.fillTriangle(eyeRx, eyeRy-1, eyeRx+eyeRwidthCurrent, eyeRy-1, eyeRx, eyeRy+eyelidsAngryHeight-1, BGCOLOR); // right eye
     } else {
       // Cyclops angry eyelids
-      display->fillTriangle(eyeLx, eyeLy-1, eyeLx+(eyeLwidthCurrent/2), eyeLy-1, eyeLx+(eyeLwidthCurrent/2), eyeLy+eyelidsAngryHeight-1, BGCOLOR); // left eyelid half
-      display->fillTriangle(eyeLx+(eyeLwidthCurrent/2), eyeLy-1, eyeLx+eyeLwidthCurrent, eyeLy-1, eyeLx+(eyeLwidthCurrent/2), eyeLy+eyelidsAngryHeight-1, BGCOLOR); // right eyelid half
+      gfx.fillTriangle(eyeLx, eyeLy-1, eyeLx+(eyeLwidthCurrent/2), eyeLy-1, eyeLx+(eyeLwidthCurrent/2), eyeLy+eyelidsAngryHeight-1, BGCOLOR); // left eyelid half
+      gfx.fillTriangle(eyeLx+(eyeLwidthCurrent/2), eyeLy-1, eyeLx+eyeLwidthCurrent, eyeLy-1, eyeLx+(eyeLwidthCurrent/2), eyeLy+eyelidsAngryHeight-1, BGCOLOR); // right eyelid half
     }
 
   // Draw happy bottom eyelids
     eyelidsHappyBottomOffset = (eyelidsHappyBottomOffset + eyelidsHappyBottomOffsetNext)/2;
-    display->fillRoundRect(eyeLx-1, (eyeLy+eyeLheightCurrent)-eyelidsHappyBottomOffset+1, eyeLwidthCurrent+2, eyeLheightDefault, eyeLborderRadiusCurrent, BGCOLOR); // left eye
+    gfx.fillRoundRect(eyeLx-1, (eyeLy+eyeLheightCurrent)-eyelidsHappyBottomOffset+1, eyeLwidthCurrent+2, eyeLheightDefault, eyeLborderRadiusCurrent, BGCOLOR); // left eye
     if (!cyclops){ 
-      display->fillRoundRect(eyeRx-1, (eyeRy+eyeRheightCurrent)-eyelidsHappyBottomOffset+1, eyeRwidthCurrent+2, eyeRheightDefault, eyeRborderRadiusCurrent, BGCOLOR); // right eye
+      gfx.fillRoundRect(eyeRx-1, (eyeRy+eyeRheightCurrent)-eyelidsHappyBottomOffset+1, eyeRwidthCurrent+2, eyeRheightDefault, eyeRborderRadiusCurrent, BGCOLOR); // right eye
     }
 
   // Add sweat drops
@@ -874,7 +952,7 @@ void drawEyes(){
       if(sweat1YPos <= sweat1YPosMax/2){sweat1Width+=0.5; sweat1Height+=0.5;} // shape grows in first half of animation ...
       else {sweat1Width-=0.1; sweat1Height-=0.5;} // ... and shrinks in second half of animation
       sweat1XPos = sweat1XPosInitial-(sweat1Width/2); // keep the growing shape centered to initial x position
-      display->fillRoundRect(sweat1XPos, sweat1YPos, sweat1Width, sweat1Height, sweatBorderradius, MAINCOLOR); // draw sweat drop
+      gfx.fillRoundRect(sweat1XPos, sweat1YPos, sweat1Width, sweat1Height, sweatBorderradius, MAINCOLOR); // draw sweat drop
 
 
       // Sweat drop 2 -> center area
@@ -883,7 +961,7 @@ void drawEyes(){
       if(sweat2YPos <= sweat2YPosMax/2){sweat2Width+=0.5; sweat2Height+=0.5;} // shape grows in first half of animation ...
       else {sweat2Width-=0.1; sweat2Height-=0.5;} // ... and shrinks in second half of animation
       sweat2XPos = sweat2XPosInitial-(sweat2Width/2); // keep the growing shape centered to initial x position
-      display->fillRoundRect(sweat2XPos, sweat2YPos, sweat2Width, sweat2Height, sweatBorderradius, MAINCOLOR); // draw sweat drop
+      gfx.fillRoundRect(sweat2XPos, sweat2YPos, sweat2Width, sweat2Height, sweatBorderradius, MAINCOLOR); // draw sweat drop
 
 
       // Sweat drop 3 -> right corner
@@ -892,7 +970,7 @@ void drawEyes(){
       if(sweat3YPos <= sweat3YPosMax/2){sweat3Width+=0.5; sweat3Height+=0.5;} // shape grows in first half of animation ...
       else {sweat3Width-=0.1; sweat3Height-=0.5;} // ... and shrinks in second half of animation
       sweat3XPos = sweat3XPosInitial-(sweat3Width/2); // keep the growing shape centered to initial x position
-      display->fillRoundRect(sweat3XPos, sweat3YPos, sweat3Width, sweat3Height, sweatBorderradius, MAINCOLOR); // draw sweat drop
+      gfx.fillRoundRect(sweat3XPos, sweat3YPos, sweat3Width, sweat3Height, sweatBorderradius, MAINCOLOR); // draw sweat drop
     }
 // === NEW FEATURES DRAWING CODE - Add before display->display() ===
 
@@ -943,9 +1021,9 @@ void drawEyes(){
     pupilLy = eyeLy + (eyeLheightCurrent/2) + pupilOffsetY;
     pupilRx = eyeRx + (eyeRwidthCurrent/2) + pupilOffsetX;
     pupilRy = eyeRy + (eyeRheightCurrent/2) + pupilOffsetY;
-    display->fillCircle(pupilLx, pupilLy, pupilSize/2, BGCOLOR);
+    gfx.fillCircle(pupilLx, pupilLy, pupilSize/2, BGCOLOR);
     if(!cyclops){
-      display->fillCircle(pupilRx, pupilRy, pupilSize/2, BGCOLOR);
+      gfx.fillCircle(pupilRx, pupilRy, pupilSize/2, BGCOLOR);
     }
   }
 
@@ -960,14 +1038,14 @@ void drawEyes(){
     
     for(int i = 0; i < eyebrowHeight; i++){
       int angleOffset = map(i, 0, eyebrowHeight, 0, eyebrowLangle);
-      display->drawLine(eyebrowLx, eyebrowLy + i + abs(eyebrowLangle) - angleOffset, 
+      gfx.drawLine(eyebrowLx, eyebrowLy + i + abs(eyebrowLangle) - angleOffset, 
                        eyebrowLx + eyebrowWidth, eyebrowLy + i - angleOffset, MAINCOLOR);
     }
     
     if(!cyclops){
       for(int i = 0; i < eyebrowHeight; i++){
         int angleOffset = map(i, 0, eyebrowHeight, 0, eyebrowRangle);
-        display->drawLine(eyebrowRx, eyebrowRy + i - angleOffset, 
+        gfx.drawLine(eyebrowRx, eyebrowRy + i - angleOffset, 
                          eyebrowRx + eyebrowWidth, eyebrowRy + i + abs(eyebrowRangle) - angleOffset, MAINCOLOR);
       }
     }
@@ -993,7 +1071,7 @@ void drawEyes(){
           tear1Width -= 0.05;
           tear1Height -= 0.1;
         }
-        display->fillRoundRect(tear1XPos, tear1YPos, tear1Width, tear1Height, tearBorderRadius, MAINCOLOR);
+        gfx.fillRoundRect(tear1XPos, tear1YPos, tear1Width, tear1Height, tearBorderRadius, MAINCOLOR);
       } else {
         tear1Active = 0;
       }
@@ -1018,7 +1096,7 @@ void drawEyes(){
             tear2Width -= 0.05;
             tear2Height -= 0.1;
           }
-          display->fillRoundRect(tear2XPos, tear2YPos, tear2Width, tear2Height, tearBorderRadius, MAINCOLOR);
+          gfx.fillRoundRect(tear2XPos, tear2YPos, tear2Width, tear2Height, tearBorderRadius, MAINCOLOR);
         } else {
           tear2Active = 0;
         }
@@ -1034,25 +1112,25 @@ void drawEyes(){
       heart3Y -= 0.6;
       
       if(heart1Y > 0){
-        display->fillCircle(heart1X - heart1Size/2, heart1Y, heart1Size/2, MAINCOLOR);
-        display->fillCircle(heart1X + heart1Size/2, heart1Y, heart1Size/2, MAINCOLOR);
-        display->fillTriangle(heart1X - heart1Size, heart1Y, 
+        gfx.fillCircle(heart1X - heart1Size/2, heart1Y, heart1Size/2, MAINCOLOR);
+        gfx.fillCircle(heart1X + heart1Size/2, heart1Y, heart1Size/2, MAINCOLOR);
+        gfx.fillTriangle(heart1X - heart1Size, heart1Y, 
                              heart1X + heart1Size, heart1Y,
                              heart1X, heart1Y + heart1Size, MAINCOLOR);
       }
       
       if(heart2Y > 0){
-        display->fillCircle(heart2X - heart2Size/2, heart2Y, heart2Size/2, MAINCOLOR);
-        display->fillCircle(heart2X + heart2Size/2, heart2Y, heart2Size/2, MAINCOLOR);
-        display->fillTriangle(heart2X - heart2Size, heart2Y, 
+        gfx.fillCircle(heart2X - heart2Size/2, heart2Y, heart2Size/2, MAINCOLOR);
+        gfx.fillCircle(heart2X + heart2Size/2, heart2Y, heart2Size/2, MAINCOLOR);
+        gfx.fillTriangle(heart2X - heart2Size, heart2Y, 
                              heart2X + heart2Size, heart2Y,
                              heart2X, heart2Y + heart2Size, MAINCOLOR);
       }
       
       if(heart3Y > 0){
-        display->fillCircle(heart3X - heart3Size/2, heart3Y, heart3Size/2, MAINCOLOR);
-        display->fillCircle(heart3X + heart3Size/2, heart3Y, heart3Size/2, MAINCOLOR);
-        display->fillTriangle(heart3X - heart3Size, heart3Y, 
+        gfx.fillCircle(heart3X - heart3Size/2, heart3Y, heart3Size/2, MAINCOLOR);
+        gfx.fillCircle(heart3X + heart3Size/2, heart3Y, heart3Size/2, MAINCOLOR);
+        gfx.fillTriangle(heart3X - heart3Size, heart3Y, 
                              heart3X + heart3Size, heart3Y,
                              heart3X, heart3Y + heart3Size, MAINCOLOR);
       }
@@ -1089,17 +1167,17 @@ void drawEyes(){
       zzz3Y = eyeRy + 15;
     }
     
-    display->drawLine(zzz1X, zzz1Y, zzz1X + zzz1Size, zzz1Y, MAINCOLOR);
-    display->drawLine(zzz1X + zzz1Size, zzz1Y, zzz1X, zzz1Y + zzz1Size, MAINCOLOR);
-    display->drawLine(zzz1X, zzz1Y + zzz1Size, zzz1X + zzz1Size, zzz1Y + zzz1Size, MAINCOLOR);
+    gfx.drawLine(zzz1X, zzz1Y, zzz1X + zzz1Size, zzz1Y, MAINCOLOR);
+    gfx.drawLine(zzz1X + zzz1Size, zzz1Y, zzz1X, zzz1Y + zzz1Size, MAINCOLOR);
+    gfx.drawLine(zzz1X, zzz1Y + zzz1Size, zzz1X + zzz1Size, zzz1Y + zzz1Size, MAINCOLOR);
     
-    display->drawLine(zzz2X, zzz2Y, zzz2X + zzz2Size, zzz2Y, MAINCOLOR);
-    display->drawLine(zzz2X + zzz2Size, zzz2Y, zzz2X, zzz2Y + zzz2Size, MAINCOLOR);
-    display->drawLine(zzz2X, zzz2Y + zzz2Size, zzz2X + zzz2Size, zzz2Y + zzz2Size, MAINCOLOR);
+    gfx.drawLine(zzz2X, zzz2Y, zzz2X + zzz2Size, zzz2Y, MAINCOLOR);
+    gfx.drawLine(zzz2X + zzz2Size, zzz2Y, zzz2X, zzz2Y + zzz2Size, MAINCOLOR);
+    gfx.drawLine(zzz2X, zzz2Y + zzz2Size, zzz2X + zzz2Size, zzz2Y + zzz2Size, MAINCOLOR);
     
-    display->drawLine(zzz3X, zzz3Y, zzz3X + zzz3Size, zzz3Y, MAINCOLOR);
-    display->drawLine(zzz3X + zzz3Size, zzz3Y, zzz3X, zzz3Y + zzz3Size, MAINCOLOR);
-    display->drawLine(zzz3X, zzz3Y + zzz3Size, zzz3X + zzz3Size, zzz3Y + zzz3Size, MAINCOLOR);
+    gfx.drawLine(zzz3X, zzz3Y, zzz3X + zzz3Size, zzz3Y, MAINCOLOR);
+    gfx.drawLine(zzz3X + zzz3Size, zzz3Y, zzz3X, zzz3Y + zzz3Size, MAINCOLOR);
+    gfx.drawLine(zzz3X, zzz3Y + zzz3Size, zzz3X + zzz3Size, zzz3Y + zzz3Size, MAINCOLOR);
   }
 
   // Draw shimmer
@@ -1109,13 +1187,13 @@ void drawEyes(){
       shimmerTimer = millis();
     }
     if(shimmerToggle){
-      display->drawPixel(eyeLx + 3, eyeLy + 3, MAINCOLOR);
-      display->drawPixel(eyeLx + 4, eyeLy + 3, MAINCOLOR);
-      display->drawPixel(eyeLx + 3, eyeLy + 4, MAINCOLOR);
+      gfx.drawPixel(eyeLx + 3, eyeLy + 3, MAINCOLOR);
+      gfx.drawPixel(eyeLx + 4, eyeLy + 3, MAINCOLOR);
+      gfx.drawPixel(eyeLx + 3, eyeLy + 4, MAINCOLOR);
       if(!cyclops){
-        display->drawPixel(eyeRx + eyeRwidthCurrent - 4, eyeRy + 3, MAINCOLOR);
-        display->drawPixel(eyeRx + eyeRwidthCurrent - 5, eyeRy + 3, MAINCOLOR);
-        display->drawPixel(eyeRx + eyeRwidthCurrent - 4, eyeRy + 4, MAINCOLOR);
+        gfx.drawPixel(eyeRx + eyeRwidthCurrent - 4, eyeRy + 3, MAINCOLOR);
+        gfx.drawPixel(eyeRx + eyeRwidthCurrent - 5, eyeRy + 3, MAINCOLOR);
+        gfx.drawPixel(eyeRx + eyeRwidthCurrent - 4, eyeRy + 4, MAINCOLOR);
       }
     }
   }
@@ -1128,11 +1206,11 @@ void drawEyes(){
         float angle = dizzyAngle + (i * PI/2);
         int starX = screenWidth/2 + cos(angle) * 35;
         int starY = screenHeight/2 + sin(angle) * 25;
-        display->drawPixel(starX, starY, MAINCOLOR);
-        display->drawPixel(starX+1, starY, MAINCOLOR);
-        display->drawPixel(starX-1, starY, MAINCOLOR);
-        display->drawPixel(starX, starY+1, MAINCOLOR);
-        display->drawPixel(starX, starY-1, MAINCOLOR);
+        gfx.drawPixel(starX, starY, MAINCOLOR);
+        gfx.drawPixel(starX+1, starY, MAINCOLOR);
+        gfx.drawPixel(starX-1, starY, MAINCOLOR);
+        gfx.drawPixel(starX, starY+1, MAINCOLOR);
+        gfx.drawPixel(starX, starY-1, MAINCOLOR);
       }
     } else {
       dizzy = 0;
@@ -1148,16 +1226,78 @@ void drawEyes(){
     int veinX = screenWidth/2;
     int veinY = 8;
     if(angryVeinPulse){
-      display->drawLine(veinX-3, veinY, veinX-1, veinY-3, MAINCOLOR);
-      display->drawLine(veinX-1, veinY-3, veinX+1, veinY, MAINCOLOR);
-      display->drawLine(veinX+1, veinY, veinX+3, veinY-3, MAINCOLOR);
+      gfx.drawLine(veinX-3, veinY, veinX-1, veinY-3, MAINCOLOR);
+      gfx.drawLine(veinX-1, veinY-3, veinX+1, veinY, MAINCOLOR);
+      gfx.drawLine(veinX+1, veinY, veinX+3, veinY-3, MAINCOLOR);
     }
   }
   display->display();
    // show drawings on display
 
+  if(flashSoftware){
+    uint16_t t = BGCOLOR; BGCOLOR = MAINCOLOR; MAINCOLOR = t;
+  }
+  updateHardwareEffects(startLineNext);
+
 } // end of drawEyes method
 
+// Send the effect commands for this frame: start line, contrast fade step,
+// invert. Each is a command or two, and only sent when its value changes
+void updateHardwareEffects(byte startLineNext){
+  if(startLineNext != startLine && hwStartLine(display, startLineNext, 0)){
+    startLine = startLineNext;
+  }
+  if(contrastCurrent != contrastTarget){
+    int c = contrastCurrent;
+    c += (contrastTarget > c) ? contrastStep : -contrastStep;
+    if((contrastTarget > contrastCurrent) ? (c > contrastTarget) : (c < contrastTarget)){
+      c = contrastTarget;
+    }
+    contrastCurrent = c;
+    hwContrast(display, contrastCurrent, 0);
+  }
+  bool invert = flash && hasInvert(&AdafruitDisplay::invertDisplay);
+  if(invert != flashInverted){
+    display->invertDisplay(invert);
+    flashInverted = invert;
+  }
+}
+
+// A start line shake by dy rows wraps the 64 rows of controller RAM, so it
+// is only used on 64-row screens, and only while the eyes stay clear of
+// the edge that wraps around. The start line moves controller rows, which
+// are screen rows (top down) only without rotation
+bool canShake(int dy){
+  if(screenHeight != 64 || display->getRotation() != 0) return false;
+  int top = eyeLy, bottom = eyeLy+eyeLheightCurrent;
+  if(!cyclops){
+    top = min(top, eyeRy);
+    bottom = max(bottom, eyeRy+eyeRheightCurrent);
+  }
+  return (dy < 0) ? (top >= -dy) : (bottom+dy <= screenHeight);
+}
+
+// Display capabilities, resolved at compile time. The hw... calls return
+// false and do nothing when the display class has no such command
+template<class D> static auto hwStartLine(D *d, byte line, int) -> decltype(d->setStartLine(line), bool()) {
+  d->setStartLine(line);
+  return true;
+}
+template<class D> static bool hwStartLine(D *, byte, long) { return false; }
+template<class D> static auto hwContrast(D *d, byte level, int) -> decltype(d->setContrast(level), bool()) {
+  d->setContrast(level);
+  return true;
+}
+template<class D> static bool hwContrast(D *, byte, long) { return false; }
+template<class D> static auto hwInitContrast(D *d, byte *level, int) -> decltype(d->getInitContrast(), bool()) {
+  *level = d->getInitContrast();
+  return true;
+}
+template<class D> static bool hwInitContrast(D *, byte *, long) { return false; }
+// true if invertDisplay() is the display's own, not Adafruit_GFX's no-op
+template<class C, class A> static constexpr bool hasInvert(void (C::*)(A)) { return true; }
+static constexpr bool hasInvert(void (Adafruit_GFX::*)(bool)) { return false; }
+
 
 }; // end of class roboEyes
 
@@ -116,6 +116,9 @@ Adafruit_BusIO_Register::Adafruit_BusIO_Register(
  * uncheckable)
  */
 bool Adafruit_BusIO_Register::write(uint8_t *buffer, uint8_t len) {
+  if (_map && _map->covers(_address, len)) {
+    return _map->write(_address, buffer, len);
+  }
   uint8_t addrbuffer[2] = {(uint8_t)(_address & 0xFF),
                            (uint8_t)(_address >> 8)};
   if (_i2cdevice) {
@@ -217,6 +220,9 @@ uint32_t Adafruit_BusIO_Register::readCached(void) { return _cached; }
    @return true on successful read, otherwise false
 */
 bool Adafruit_BusIO_Register::read(uint8_t *buffer, uint8_t len) {
+  if (_map && _map->covers(_address, len)) {
+    return _map->read(_address, buffer, len);
+  }
   uint8_t addrbuffer[2] = {(uint8_t)(_address & 0xFF),
                            (uint8_t)(_address >> 8)};
   if (_i2cdevice) {
@@ -381,4 +387,254 @@ void Adafruit_BusIO_Register::setAddressWidth(uint16_t address_width) {
   _addrwidth = address_width;
 }
 
+/*!
+ *    @brief  Read and write this register through a register map's cache
+ * (see Adafruit_BusIO_RegisterMap). Accesses that don't lie wholly within
+ * the map's registers still go straight to the bus.
+ *    @param map The map to use, or nullptr to stop using one
+ */
+void Adafruit_BusIO_Register::setMap(Adafruit_BusIO_RegisterMap *map) {
+  _map = map;
+}
+
+/*!
+ *    @brief  Create a register map over I2C
+ *    @param  i2cdevice The I2CDevice to use for underlying I2C access
+ *    @param  first_reg The address of the first register in the map
+ *    @param  count The number of consecutive registers (bytes) in the map
+ *    @param  address_width The width of the register address itself, defaults
+ * to 1 byte
+ */
+Adafruit_BusIO_RegisterMap::Adafruit_BusIO_RegisterMap(
+    Adafruit_I2CDevice *i2cdevice, uint16_t first_reg, uint16_t count,
+    uint8_t address_width)
+    : Adafruit_BusIO_RegisterMap(i2cdevice, nullptr, ADDRBIT8_HIGH_TOREAD,
+                                 first_reg, count, address_width) {}
+
+/*!
+ *    @brief  Create a register map over an I2C or SPI Device, as with the
+ * matching Adafruit_BusIO_Register constructor
+ *    @param  i2cdevice The I2CDevice to use for underlying I2C access, if
+ * nullptr we use SPI
+ *    @param  spidevice The SPIDevice to use for underlying SPI access, if
+ * nullptr we use I2C
+ *    @param  type     The method we use to read/write data to SPI. It has to
+ * auto-increment the address for multi-register writes.
+ *    @param  first_reg The address of the first register in the map
+ *    @param  count The number of consecutive registers (bytes) in the map
+ *    @param  address_width The width of the register address itself, defaults
+ * to 1 byte
+ */
+Adafruit_BusIO_RegisterMap::Adafruit_BusIO_RegisterMap(
+    Adafruit_I2CDevice *i2cdevice, Adafruit_SPIDevice *spidevice,
+    Adafruit_BusIO_SPIRegType type, uint16_t first_reg, uint16_t count,
+    uint8_t address_width)
+    : _bus(i2cdevice, spidevice, type, first_reg, 1, LSBFIRST, address_width),
+      _i2cdevice(i2cdevice), _first(first_reg), _count(count),
+      _addrwidth(address_width) {
+  uint16_t bitmap = (count + 7) / 8;
+  _cache = new uint8_t[count + 2 * bitmap]();
+  _valid = _cache + count;
+  _dirty = _valid + bitmap;
+}
+
+/*!
+ *    @brief  Free the cache. Pending writes are dropped.
+ */
+Adafruit_BusIO_RegisterMap::~Adafruit_BusIO_RegisterMap(void) {
+  delete[] _cache;
+}
+
+/*!
+ *    @brief  Fill the cache with every register in the map, in as few
+ * multi-register reads as fit (32 registers each). Registers with pending
+ * writes keep their new values.
+ *    @return True on successful read, otherwise false
+ */
+bool Adafruit_BusIO_RegisterMap::load(void) { return fetch(0, _count); }
+
+/*!
+ *    @brief  Forget every cached value, e.g. after the device was reset.
+ * Pending writes are dropped.
+ */
+void Adafruit_BusIO_RegisterMap::invalidate(void) {
+  memset(_valid, 0, 2 * ((_count + 7) / 8));
+}
+
+/*!
+ *    @brief  Start holding writes in the cache, until the matching
+ * endBatch(). Batches can be nested; only the outermost one flushes.
+ */
+void Adafruit_BusIO_RegisterMap::beginBatch(void) { _depth++; }
+
+/*!
+ *    @brief  End a batch. Ending the outermost one flushes the map.
+ *    @return True if nothing failed to flush, otherwise false
+ */
+bool Adafruit_BusIO_RegisterMap::endBatch(void) {
+  if (_depth && --_depth) {
+    return true;
+  }
+  return flush();
+}
+
+/*!
+ *    @brief  Write out every pending register, each run of consecutive ones
+ * as a single multi-register write (split where it wouldn't fit the I2C
+ * buffer). A run that fails stays pending.
+ *    @return True if every write was successful, otherwise false
+ */
+bool Adafruit_BusIO_RegisterMap::flush(void) {
+  size_t max = 255;
+  if (_i2cdevice && (_i2cdevice->maxBufferSize() - _addrwidth < max)) {
+    max = _i2cdevice->maxBufferSize() - _addrwidth;
+  }
+  bool ok = true;
+  for (uint16_t i = 0; i < _count;) {
+    if (!test(_dirty, i)) {
+      i++;
+      continue;
+    }
+    uint16_t n = 1;
+    while ((i + n < _count) && (n < max) && test(_dirty, i + n)) {
+      n++;
+    }
+    _bus.setAddress(_first + i);
+    if (_bus.write(_cache + i, n)) {
+      for (uint16_t k = i; k < i + n; k++) {
+        mark(_dirty, k, false);
+      }
+    } else {
+      ok = false;
+    }
+    i += n;
+  }
+  return ok;
+}
+
+/*!
+ *    @brief  Check for writes held in the cache
+ *    @return True if any register has a pending write
+ */
+bool Adafruit_BusIO_RegisterMap::dirty(void) {
+  for (uint16_t i = 0; i < (_count + 7) / 8; i++) {
+    if (_dirty[i]) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/*!
+ *    @brief  Check whether registers lie wholly within the map
+ *    @param  reg Address of the first register
+ *    @param  len Number of registers (bytes)
+ *    @return True if the map holds all of them
+ */
+bool Adafruit_BusIO_RegisterMap::covers(uint16_t reg, uint8_t len) {
+  return (reg >= _first) && ((uint32_t)reg + len <= (uint32_t)_first + _count);
+}
+
+/*!
+ *    @brief  Read registers from the cache, or from the bus (into the cache)
+ * if any of them isn't cached yet. Pending writes win over what the device
+ * returns.
+ *    @param  reg Address of the first register
+ *    @param  buffer Buffer to read data into
+ *    @param  len Number of registers (bytes) to read
+ *    @return True on successful read, otherwise false
+ */
+bool Adafruit_BusIO_RegisterMap::read(uint16_t reg, uint8_t *buffer,
+                                      uint8_t len) {
+  uint16_t at = reg - _first;
+  for (uint8_t i = 0; i < len; i++) {
+    if (!test(_valid, at + i)) {
+      if (!fetch(at, len)) {
+        return false;
+      }
+      break;
+    }
+  }
+  memcpy(buffer, _cache + at, len);
+  return true;
+}
+
+/*!
+ *    @brief  Write registers to the cache, and to the bus unless a batch is
+ * open. Within a batch a register already cached with the same value, and
+ * not pending, is left out of the flush.
+ *    @param  reg Address of the first register
+ *    @param  buffer Pointer to data to write
+ *    @param  len Number of registers (bytes) to write
+ *    @return True if written (or held for the batch), otherwise false
+ */
+bool Adafruit_BusIO_RegisterMap::write(uint16_t reg, const uint8_t *buffer,
+                                       uint8_t len) {
+  uint16_t at = reg - _first;
+  if (_depth) {
+    for (uint8_t i = 0; i < len; i++, at++) {
+      if (!test(_valid, at) || (_cache[at] != buffer[i])) {
+        _cache[at] = buffer[i];
+        mark(_valid, at, true);
+        mark(_dirty, at, true);
+      }
+    }
+    return true;
+  }
+  memcpy(_cache + at, buffer, len);
+  for (uint8_t i = 0; i < len; i++) {
+    mark(_valid, at + i, true);
+    mark(_dirty, at + i, false);
+  }
+  _bus.setAddress(reg);
+  if (_bus.write(_cache + at, len)) {
+    return true;
+  }
+  for (uint8_t i = 0; i < len; i++) {
+    mark(_valid, at + i, false);
+  }
+  return false;
+}
+
+/*!
+ *    @brief  Read registers from the bus into the cache, as one
+ * multi-register read per 32 of them. Registers with pending writes keep
+ * their new values.
+ *    @param  at Index of the first register within the map
+ *    @param  len Number of registers (bytes) to read
+ *    @return True on successful read, otherwise false
+ */
+bool Adafruit_BusIO_RegisterMap::fetch(uint16_t at, uint16_t len) {
+  uint8_t buffer[32];
+  while (len) {
+    uint8_t n = (len > sizeof(buffer)) ? sizeof(buffer) : len;
+    _bus.setAddress(_first + at);
+    if (!_bus.read(buffer, n)) {
+      return false;
+    }
+    for (uint8_t i = 0; i < n; i++, at++) {
+      if (!test(_dirty, at)) {
+        _cache[at] = buffer[i];
+        mark(_valid, at, true);
+      }
+    }
+    len -= n;
+  }
+  return true;
+}
+
+/*!
+ *    @brief  Set or clear one register's bit in a bitmap
+ *    @param  bits The valid or dirty bitmap
+ *    @param  i Register index within the map
+ *    @param  on Whether to set the bit
+ */
+void Adafruit_BusIO_RegisterMap::mark(uint8_t *bits, uint16_t i, bool on) {
+  if (on) {
+    bits[i / 8] |= 1 << (i % 8);
+  } else {
+    bits[i / 8] &= ~(1 << (i % 8));
+  }
+}
+
 #endif // SPI exists
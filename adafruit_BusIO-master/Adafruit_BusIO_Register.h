@@ -37,6 +37,8 @@ typedef enum _Adafruit_BusIO_SPIRegType {
 
 } Adafruit_BusIO_SPIRegType;
 
+class Adafruit_BusIO_RegisterMap;
+
 /*!
  * @brief The class which defines a device register (a location to read/write
  * data from)
@@ -76,6 +78,7 @@ public:
   void setWidth(uint8_t width);
   void setAddress(uint16_t address);
   void setAddressWidth(uint16_t address_width);
+  void setMap(Adafruit_BusIO_RegisterMap *map);
 
 #if !defined(NO_GLOBAL_INSTANCES) && !defined(NO_GLOBAL_SERIAL)
   void print(Stream *s = &Serial);
@@ -95,6 +98,7 @@ private:
   uint8_t _buffer[4]; // we won't support anything larger than uint32 for
                       // non-buffered read
   uint32_t _cached = 0;
+  Adafruit_BusIO_RegisterMap *_map = nullptr;
 };
 
 /*!
@@ -113,5 +117,91 @@ private:
   uint8_t _bits, _shift;
 };
 
+/*!
+ * @brief A write-back cache for a block of consecutive byte registers, e.g.
+ * a device's configuration registers. Registers attached with
+ * Adafruit_BusIO_Register::setMap() read from the cache once it holds their
+ * bytes, so a bitfield read-modify-write costs no bus read. Inside a batch
+ * (beginBatch()/endBatch() or an Adafruit_BusIO_RegisterBatch) their writes
+ * only change the cache, and flush() sends each run of changed registers
+ * as one multi-register write, relying on the device's address
+ * auto-increment. Outside a batch writes go straight through.
+ *
+ * Only attach registers that the device doesn't change by itself (not
+ * status or data registers), as their cached values are trusted.
+ */
+class Adafruit_BusIO_RegisterMap {
+public:
+  Adafruit_BusIO_RegisterMap(Adafruit_I2CDevice *i2cdevice, uint16_t first_reg,
+                             uint16_t count, uint8_t address_width = 1);
+  Adafruit_BusIO_RegisterMap(Adafruit_I2CDevice *i2cdevice,
+                             Adafruit_SPIDevice *spidevice,
+                             Adafruit_BusIO_SPIRegType type,
+                             uint16_t first_reg, uint16_t count,
+                             uint8_t address_width = 1);
+  ~Adafruit_BusIO_RegisterMap(void);
+  /// Not copyable: the cache is owned, and registers point at one map
+  Adafruit_BusIO_RegisterMap(const Adafruit_BusIO_RegisterMap &) = delete;
+  /// Not copyable: the cache is owned, and registers point at one map
+  Adafruit_BusIO_RegisterMap &
+  operator=(const Adafruit_BusIO_RegisterMap &) = delete;
+
+  bool load(void);
+  void invalidate(void);
+  void beginBatch(void);
+  bool endBatch(void);
+  bool flush(void);
+  bool dirty(void);
+
+private:
+  friend class Adafruit_BusIO_Register;
+  bool covers(uint16_t reg, uint8_t len);
+  bool read(uint16_t reg, uint8_t *buffer, uint8_t len);
+  bool write(uint16_t reg, const uint8_t *buffer, uint8_t len);
+  bool fetch(uint16_t at, uint16_t len);
+  void mark(uint8_t *bits, uint16_t i, bool on);
+  bool test(const uint8_t *bits, uint16_t i) {
+    return bits[i / 8] & (1 << (i % 8));
+  }
+
+  Adafruit_BusIO_Register _bus; // does the bus access, at any address
+  Adafruit_I2CDevice *_i2cdevice;
+  uint16_t _first, _count;
+  uint8_t _addrwidth;
+  uint8_t _depth = 0; // beginBatch() nesting
+  uint8_t *_cache;    // _count register values, then the valid and dirty
+  uint8_t *_valid;    // bitmaps (a bit per register)
+  uint8_t *_dirty;
+};
+
+/*!
+ * @brief Batches writes to a register map for as long as it is in scope,
+ * and flushes the map when it goes out of scope. A failed flush leaves the
+ * registers pending, for a later flush() to retry and report.
+ */
+class Adafruit_BusIO_RegisterBatch {
+public:
+  /*!
+   *    @brief  Start batching writes to a register map
+   *    @param  map The map to batch
+   */
+  Adafruit_BusIO_RegisterBatch(Adafruit_BusIO_RegisterMap *map) : _map(map) {
+    _map->beginBatch();
+  }
+  /*!
+   *    @brief  End the batch, flushing the map unless this was nested in
+   * another batch
+   */
+  ~Adafruit_BusIO_RegisterBatch(void) { _map->endBatch(); }
+  /// Not copyable: each copy would end the batch again
+  Adafruit_BusIO_RegisterBatch(const Adafruit_BusIO_RegisterBatch &) = delete;
+  /// Not copyable: each copy would end the batch again
+  Adafruit_BusIO_RegisterBatch &
+  operator=(const Adafruit_BusIO_RegisterBatch &) = delete;
+
+private:
+  Adafruit_BusIO_RegisterMap *_map;
+};
+
 #endif // SPI exists
 #endif // BusIO_Register_h
@@ -11,6 +11,7 @@ Adafruit_I2CDevice::Adafruit_I2CDevice(uint8_t addr, TwoWire *theWire) {
   _addr = addr;
   _wire = theWire;
   _begun = false;
+  _lastStatus = 0;
 #ifdef ARDUINO_ARCH_SAMD
   _maxBufferSize = 250; // as defined in Wire.h's RingBuffer
 #elif defined(ESP32)
@@ -88,7 +89,7 @@ bool Adafruit_I2CDevice::detected(void) {
 
 /*!
  *    @brief  Write a buffer or two to the I2C device. Cannot be more than
- * maxBufferSize() bytes.
+ * maxBufferSize() bytes; see write_stream() for longer data.
  *    @param  buffer Pointer to buffer of data to write. This is const to
  *            ensure the content of this buffer doesn't change.
  *    @param  len Number of bytes from buffer to write
@@ -109,6 +110,7 @@ bool Adafruit_I2CDevice::write(const uint8_t *buffer, size_t len, bool stop,
 #ifdef DEBUG_SERIAL
     DEBUG_SERIAL.println(F("\tI2CDevice could not write such a large buffer"));
 #endif
+    _lastStatus = 1;
     return false;
   }
 
@@ -120,6 +122,7 @@ bool Adafruit_I2CDevice::write(const uint8_t *buffer, size_t len, bool stop,
 #ifdef DEBUG_SERIAL
       DEBUG_SERIAL.println(F("\tI2CDevice failed to write"));
 #endif
+      _lastStatus = 1;
       return false;
     }
   }
@@ -129,6 +132,7 @@ bool Adafruit_I2CDevice::write(const uint8_t *buffer, size_t len, bool stop,
 #ifdef DEBUG_SERIAL
     DEBUG_SERIAL.println(F("\tI2CDevice failed to write"));
 #endif
+    _lastStatus = 1;
     return false;
   }
 
@@ -158,7 +162,8 @@ bool Adafruit_I2CDevice::write(const uint8_t *buffer, size_t len, bool stop,
   }
 #endif
 
-  if (_wire->endTransmission(stop) == 0) {
+  _lastStatus = _wire->endTransmission(stop);
+  if (_lastStatus == 0) {
 #ifdef DEBUG_SERIAL
     DEBUG_SERIAL.println();
     // DEBUG_SERIAL.println("Sent!");
@@ -172,6 +177,62 @@ bool Adafruit_I2CDevice::write(const uint8_t *buffer, size_t len, bool stop,
   }
 }
 
+/*!
+ *    @brief  Write any amount of data to the I2C device, split into as many
+ * transactions as it takes, each starting with the same prefix. This suits
+ * devices that take a stream in pieces, each introduced by a control or
+ * command byte (e.g. 0x40 before display data on SSD1306/SH1106 OLEDs);
+ * it is not a way to write past maxBufferSize() into auto-incrementing
+ * registers, as every chunk would start again at the prefix's register.
+ *    @param  buffer Pointer to buffer of data to write. This is const to
+ *            ensure the content of this buffer doesn't change.
+ *    @param  len Number of bytes from buffer to write, any amount
+ *    @param  prefix_buffer Pointer to optional array of data to send at the
+ * start of every transaction. This is const to ensure the content of this
+ * buffer doesn't change.
+ *    @param  prefix_len Number of bytes from prefix buffer to write, less
+ * than maxBufferSize()
+ *    @param  chunk_len Most bytes of buffer per transaction, e.g. to keep
+ * each one short at a slow bus clock. 0 (or more than fits) fills the Wire
+ * buffer.
+ *    @param  repeated_start Whether to join the transactions with repeated
+ * starts rather than STOPs, keeping hold of the bus until the last one ends
+ * with a STOP. Only for devices that accept it, and ignored on ESP32, whose
+ * Wire holds back a write that doesn't end in STOP until a following read.
+ *    @return True if every transaction was successful, otherwise false. The
+ * stream ends at the first failed one, whose status lastWriteStatus() gives.
+ */
+bool Adafruit_I2CDevice::write_stream(const uint8_t *buffer, size_t len,
+                                      const uint8_t *prefix_buffer,
+                                      size_t prefix_len, size_t chunk_len,
+                                      bool repeated_start) {
+  if (prefix_buffer == nullptr)
+    prefix_len = 0;
+  if (prefix_len >= maxBufferSize()) {
+#ifdef DEBUG_SERIAL
+    DEBUG_SERIAL.println(F("\tI2CDevice prefix leaves no room for data"));
+#endif
+    return false;
+  }
+  size_t room = maxBufferSize() - prefix_len;
+  if ((chunk_len == 0) || (chunk_len > room))
+    chunk_len = room;
+#if defined(ESP32)
+  repeated_start = false;
+#endif
+
+  size_t pos = 0;
+  while (pos < len) {
+    size_t n = ((len - pos) > chunk_len) ? chunk_len : (len - pos);
+    bool last = (pos + n) >= len;
+    if (!write(buffer + pos, n, last || !repeated_start, prefix_buffer,
+               prefix_len))
+      return false;
+    pos += n;
+  }
+  return true;
+}
+
 /*!
  *    @brief  Read from I2C into a buffer from the I2C device.
  *    Cannot be more than maxBufferSize() bytes.
@@ -16,6 +16,10 @@ public:
   bool read(uint8_t *buffer, size_t len, bool stop = true);
   bool write(const uint8_t *buffer, size_t len, bool stop = true,
              const uint8_t *prefix_buffer = nullptr, size_t prefix_len = 0);
+  bool write_stream(const uint8_t *buffer, size_t len,
+                    const uint8_t *prefix_buffer = nullptr,
+                    size_t prefix_len = 0, size_t chunk_len = 0,
+                    bool repeated_start = false);
   bool write_then_read(const uint8_t *write_buffer, size_t write_len,
                        uint8_t *read_buffer, size_t read_len,
                        bool stop = false);
@@ -25,11 +29,18 @@ public:
    *    @return The size of the Wire receive/transmit buffer */
   size_t maxBufferSize() { return _maxBufferSize; }
 
+  /*!   @brief  The outcome of the last write(), as Wire's endTransmission()
+   *    reports it: 0 success, 1 data too long for the buffer, 2 NACK on the
+   *    address, 3 NACK on data, 4 other error, 5 timeout
+   *    @return The status, 0 if nothing has been written yet */
+  uint8_t lastWriteStatus() { return _lastStatus; }
+
 private:
   uint8_t _addr;
   TwoWire *_wire;
   bool _begun;
   size_t _maxBufferSize;
+  uint8_t _lastStatus;
   bool _read(uint8_t *buffer, size_t len, bool stop);
 };
 
@@ -0,0 +1,101 @@
+// Batched register writes with Adafruit_BusIO_RegisterMap, on an MPU-6050
+// (I2C address 0x68). Its sample rate divider, filter and full-scale range
+// settings live in four consecutive registers, 0x19 to 0x1C. Written field
+// by field, each bitfield costs a read and a write on the bus; through a
+// register map the fields are set in RAM and go out as one multi-register
+// write.
+
+#include <Adafruit_BusIO_Register.h>
+#include <Adafruit_I2CDevice.h>
+
+#define I2C_ADDRESS 0x68
+Adafruit_I2CDevice i2c_dev = Adafruit_I2CDevice(I2C_ADDRESS);
+
+// SMPLRT_DIV, CONFIG, GYRO_CONFIG and ACCEL_CONFIG. Only registers the
+// device doesn't change by itself belong in a map.
+Adafruit_BusIO_RegisterMap config_map(&i2c_dev, 0x19, 4);
+
+Adafruit_BusIO_Register smplrt_div = Adafruit_BusIO_Register(&i2c_dev, 0x19);
+Adafruit_BusIO_Register config = Adafruit_BusIO_Register(&i2c_dev, 0x1A);
+Adafruit_BusIO_Register gyro_config = Adafruit_BusIO_Register(&i2c_dev, 0x1B);
+Adafruit_BusIO_Register accel_config = Adafruit_BusIO_Register(&i2c_dev, 0x1C);
+// outside the map, so written straight through
+Adafruit_BusIO_Register pwr_mgmt_1 = Adafruit_BusIO_Register(&i2c_dev, 0x6B);
+
+Adafruit_BusIO_RegisterBits dlpf_cfg =
+    Adafruit_BusIO_RegisterBits(&config, 3, 0);
+Adafruit_BusIO_RegisterBits gyro_range =
+    Adafruit_BusIO_RegisterBits(&gyro_config, 2, 3);
+Adafruit_BusIO_RegisterBits accel_range =
+    Adafruit_BusIO_RegisterBits(&accel_config, 2, 3);
+
+void printConfig(void) {
+  Serial.print("SMPLRT_DIV = ");
+  Serial.print(smplrt_div.read());
+  Serial.print(", DLPF_CFG = ");
+  Serial.print(dlpf_cfg.read());
+  Serial.print(", FS_SEL = ");
+  Serial.print(gyro_range.read());
+  Serial.print(", AFS_SEL = ");
+  Serial.println(accel_range.read());
+}
+
+void setup() {
+  while (!Serial) {
+    delay(10);
+  }
+  Serial.begin(115200);
+  Serial.println("I2C register map test");
+
+  if (!i2c_dev.begin()) {
+    Serial.print("Did not find device at 0x");
+    Serial.println(i2c_dev.address(), HEX);
+    while (1)
+      ;
+  }
+  Serial.print("Device found on address 0x");
+  Serial.println(i2c_dev.address(), HEX);
+
+  pwr_mgmt_1.write(0x01); // wake up, clocked from the X gyro PLL
+
+  smplrt_div.setMap(&config_map);
+  config.setMap(&config_map);
+  gyro_config.setMap(&config_map);
+  accel_config.setMap(&config_map);
+
+  // One read fills the cache, so the bitfield writes below need none
+  if (!config_map.load()) {
+    Serial.println("Couldn't read the configuration registers");
+    while (1)
+      ;
+  }
+  printConfig();
+
+  // Writes inside the scope only change the cache. Leaving it flushes the
+  // map: all four registers go out in a single write.
+  {
+    Adafruit_BusIO_RegisterBatch batch(&config_map);
+    smplrt_div.write(9);  // 1 kHz / (1 + 9) = 100 Hz
+    dlpf_cfg.write(3);    // 44 Hz accel / 42 Hz gyro bandwidth
+    gyro_range.write(1);  // +/-500 deg/s
+    accel_range.write(2); // +/-8 g
+  }
+  if (config_map.dirty()) {
+    Serial.println("Flush failed, the writes are still pending");
+  }
+  printConfig();
+
+  // The same with explicit calls. Only ACCEL_CONFIG changes this time, so
+  // the flush writes just that register. endBatch() reports the flush.
+  config_map.beginBatch();
+  accel_range.write(0); // +/-2 g
+  if (!config_map.endBatch()) {
+    // a failed run stays pending, and flush() tries it again
+    if (!config_map.flush()) {
+      Serial.println("Couldn't write ACCEL_CONFIG");
+    }
+  }
+  printConfig();
+}
+
+void loop() {}
@@ -0,0 +1,43 @@
+// Timing for the host benchmarks. A measurement repeats a batch of calls
+// for at least 10 ms, 15 times over, and keeps the fastest run, so the
+// figures are per call with a warm cache and no interference. They are
+// for comparing variants on one machine, not for predicting target times.
+#pragma once
+#include <chrono>
+#include <stdint.h>
+#include <stdio.h>
+
+// ns per call for batch(), which makes calls calls
+template <class F> double benchNs(F batch, long calls) {
+  typedef std::chrono::steady_clock clk;
+  double best = 1e30;
+  for (int run = 0; run < 15; run++) {
+    long batches = 0;
+    clk::time_point t0 = clk::now();
+    clk::duration el;
+    do {
+      batch();
+      batches++;
+      el = clk::now() - t0;
+    } while (el < std::chrono::milliseconds(10));
+    double ns = std::chrono::duration<double, std::nano>(el).count() /
+                ((double)batches * calls);
+    if (ns < best)
+      best = ns;
+  }
+  return best;
+}
+
+// MB/s for batch(), which moves bytes bytes
+template <class F> double benchMBs(F batch, long bytes) {
+  return 1000.0 / benchNs(batch, bytes);
+}
+
+// repeatable inputs, so every variant sees the same calls
+static inline uint32_t benchRand(void) {
+  static uint32_t s = 2463534242u;
+  s ^= s << 13;
+  s ^= s >> 17;
+  s ^= s << 5;
+  return s;
+}
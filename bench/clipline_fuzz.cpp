@@ -0,0 +1,86 @@
+// Adafruit_GFX::drawLine() and Adafruit_GFX_Direct::drawLine() against a
+// plain Bresenham walk that tests every pixel against the display and clip
+// rect, for 200000 random lines on a GFXcanvas1 in each rotation. A third
+// of the lines have endpoints thousands of pixels off-canvas (the case the
+// analytic clipping exists for), a fifth start on the canvas, and half are
+// drawn with a random clip rect. Exits non-zero on any pixel difference.
+#include <Adafruit_GFX.h>
+#include <Adafruit_GFX_Direct.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <utility>
+
+#define W 57
+#define H 41
+#define LINES 200000L
+
+// the line Adafruit_GFX draws when nothing is clipped, one pixel at a time
+static void reference(GFXcanvas1 &c, int x0, int y0, int x1, int y1,
+                      int16_t cx, int16_t cy, int16_t cw, int16_t ch) {
+  bool steep = abs(y1 - y0) > abs(x1 - x0);
+  if (steep) {
+    std::swap(x0, y0);
+    std::swap(x1, y1);
+  }
+  if (x0 > x1) {
+    std::swap(x0, x1);
+    std::swap(y0, y1);
+  }
+  int dx = x1 - x0, dy = abs(y1 - y0), err = dx / 2, ystep = y0 < y1 ? 1 : -1;
+  for (; x0 <= x1; x0++) {
+    int px = steep ? y0 : x0, py = steep ? x0 : y0;
+    if (px >= cx && px < cx + cw && py >= cy && py < cy + ch && px >= 0 &&
+        py >= 0 && px < c.width() && py < c.height())
+      c.drawPixel(px, py, 1);
+    err -= dy;
+    if (err < 0) {
+      y0 += ystep;
+      err += dx;
+    }
+  }
+}
+
+int main() {
+  srand(7);
+  long bad = 0;
+  for (long i = 0; i < LINES; i++) {
+    int rot = rand() % 4;
+    GFXcanvas1 gfx(W, H), ref(W, H), direct(W, H);
+    Adafruit_GFX_Direct<GFXcanvas1> d(direct);
+    gfx.setRotation(rot);
+    ref.setRotation(rot);
+    direct.setRotation(rot);
+
+    int r = (i % 3 == 0) ? 3000 : 120;
+    int x0 = rand() % (2 * r) - r / 2, y0 = rand() % (2 * r) - r / 2;
+    int x1 = rand() % (2 * r) - r / 2, y1 = rand() % (2 * r) - r / 2;
+    if (i % 5 == 0) {
+      x0 = rand() % W;
+      y0 = rand() % H;
+    }
+    int cx = rand() % 70 - 10, cy = rand() % 50 - 10;
+    int cw = rand() % 70, ch = rand() % 50;
+    if (rand() % 2) {
+      gfx.setClipRect(cx, cy, cw, ch);
+      direct.setClipRect(cx, cy, cw, ch);
+    }
+    int16_t gx, gy, gw, gh; // the clip rect as the canvas stored it
+    gfx.getClipRect(&gx, &gy, &gw, &gh);
+
+    gfx.drawLine(x0, y0, x1, y1, 1);
+    d.drawLine(x0, y0, x1, y1, 1);
+    reference(ref, x0, y0, x1, y1, gx, gy, gw, gh);
+
+    size_t n = (W + 7) / 8 * H;
+    if (memcmp(gfx.getBuffer(), ref.getBuffer(), n) ||
+        memcmp(direct.getBuffer(), ref.getBuffer(), n)) {
+      if (bad < 5)
+        printf("rotation %d (%d,%d)-(%d,%d) clip %d,%d %dx%d differs\n", rot,
+               x0, y0, x1, y1, gx, gy, gw, gh);
+      bad++;
+    }
+  }
+  printf("clipline_fuzz: %ld lines, %ld differ\n", LINES, bad);
+  return bad ? 1 : 0;
+}
@@ -0,0 +1,108 @@
+// Adafruit_GFX drawChar() from a plain GFXfont against the run-length
+// encoded GFXfontRLE of the same face, at text sizes 1-3, into an
+// Adafruit_SH1106 buffer. The RLE forms are encoded here at startup the way
+// fontconvert -r writes them. Every printable glyph is drawn once per batch
+// with its baseline on row 48, so the larger sizes clip at the panel edges.
+// Both forms must leave the same buffer; the benchmark fails if they don't.
+#include "bench.h"
+#include <Adafruit_SH1106.h>
+#include <Fonts/FreeSans24pt7b.h>
+#include <Fonts/FreeSans9pt7b.h>
+#include <vector>
+
+// the framebuffer is ours, so the two forms' output can be compared
+static uint8_t fb[SH1106_LCDWIDTH * SH1106_LCDHEIGHT / 8];
+static const SH1106_Panel panel = {SH1106_LCDWIDTH, SH1106_LCDHEIGHT,
+                                   SH1106_COLUMN_OFFSET, fb, NULL};
+static Adafruit_SH1106 oled(panel);
+
+struct RLEFace {
+  std::vector<uint8_t> bitmap;
+  std::vector<GFXglyph> glyph;
+  GFXfontRLE font;
+};
+
+// nibble stream writer, high nibble first
+struct Nibbles {
+  std::vector<uint8_t> &out;
+  bool half;
+  Nibbles(std::vector<uint8_t> &o) : out(o), half(false) {}
+  void put(uint8_t v) {
+    if (half)
+      out.back() |= v;
+    else
+      out.push_back(v << 4);
+    half = !half;
+  }
+  void run(int len) {
+    for (; len >= 15; len -= 15)
+      put(15);
+    put(len);
+  }
+};
+
+static void encode(const GFXfont &f, RLEFace &r) {
+  int n = f.last - f.first + 1;
+  r.glyph.assign(f.glyph, f.glyph + n);
+  for (int c = 0; c < n; c++) {
+    const GFXglyph &g = f.glyph[c];
+    const uint8_t *src = &f.bitmap[g.bitmapOffset];
+    r.glyph[c].bitmapOffset = r.bitmap.size();
+    Nibbles nb(r.bitmap);
+    int run = 0, on = 0;
+    for (int i = 0; i < g.width * g.height; i++) {
+      int bit = (src[i / 8] >> (7 - i % 8)) & 1;
+      if (bit != on) {
+        nb.run(run);
+        run = 0;
+        on = bit;
+      }
+      run++;
+    }
+    if (g.width * g.height)
+      nb.run(run);
+  }
+  r.font.font = f;
+  r.font.font.bitmap = r.bitmap.data();
+  r.font.font.glyph = r.glyph.data();
+}
+
+static void glyphs(const GFXfont &f, uint8_t size) {
+  for (int c = f.first; c <= f.last; c++)
+    oled.drawChar(0, 48, c, WHITE, WHITE, size);
+}
+
+int main() {
+  static const struct {
+    const char *name;
+    const GFXfont *font;
+  } faces[] = {{"9pt", &FreeSans9pt7b}, {"24pt", &FreeSans24pt7b}};
+  static uint8_t plain[sizeof(fb)];
+  int bad = 0;
+
+  printf("%-6s %-5s %10s %10s   (ns per glyph, FreeSans)\n", "face", "size",
+         "plain", "RLE");
+  for (auto &face : faces) {
+    RLEFace rle;
+    encode(*face.font, rle);
+    int n = face.font->last - face.font->first + 1;
+    for (uint8_t size = 1; size <= 3; size++) {
+      oled.clearDisplay();
+      oled.setFont(face.font);
+      glyphs(*face.font, size);
+      memcpy(plain, fb, sizeof(fb));
+      double p = benchNs([&] { glyphs(*face.font, size); }, n);
+
+      oled.clearDisplay();
+      oled.setFontRLE(&rle.font);
+      glyphs(*face.font, size);
+      if (memcmp(plain, fb, sizeof(fb))) {
+        printf("%s size %d: RLE and plain glyphs differ\n", face.name, size);
+        bad++;
+      }
+      double r = benchNs([&] { glyphs(*face.font, size); }, n);
+      printf("%-6s %-5d %10.1f %10.1f\n", face.name, size, p, r);
+    }
+  }
+  return bad ? 1 : 0;
+}
@@ -0,0 +1,42 @@
+// Adafruit_GFX_Direct<Adafruit_SH1106> against the virtual Adafruit_GFX
+// calls, for the primitives RoboEyes draws its eyes with, at the sizes it
+// draws them. "frame" is one eye frame: a clear, two rounded rects, two
+// eyelid triangles, two pupils and an eyebrow line each.
+#include "bench.h"
+#include <Adafruit_SH1106.h>
+
+static Adafruit_SH1106 oled;
+static Adafruit_GFX_Direct<Adafruit_SH1106> direct(oled);
+
+template <class G> static void frame(G &g) {
+  g.fillRoundRect(18, 14, 40, 36, 8, WHITE);
+  g.fillRoundRect(70, 14, 40, 36, 8, WHITE);
+  g.fillTriangle(18, 13, 58, 13, 18, 24, BLACK);
+  g.fillTriangle(70, 13, 110, 13, 110, 24, BLACK);
+  g.fillCircle(38, 32, 6, BLACK);
+  g.fillCircle(90, 32, 6, BLACK);
+  g.drawLine(18, 8, 58, 4, WHITE);
+  g.drawLine(70, 4, 110, 8, WHITE);
+}
+
+template <class G> static void row(const char *name, G &g) {
+  double rr = benchNs([&] { g.fillRoundRect(18, 14, 40, 36, 8, WHITE); }, 1);
+  double tr = benchNs([&] { g.fillTriangle(18, 13, 58, 13, 18, 24, BLACK); }, 1);
+  double ci = benchNs([&] { g.fillCircle(38, 32, 6, BLACK); }, 1);
+  double li = benchNs([&] { g.drawLine(18, 8, 58, 4, WHITE); }, 1);
+  double fr = benchNs([&] {
+    oled.clearDisplay();
+    frame(g);
+  }, 1);
+  printf("%-8s %10.1f %10.1f %10.1f %10.1f %10.1f\n", name, rr, tr, ci, li,
+         fr);
+}
+
+int main() {
+  printf("%-8s %10s %10s %10s %10s %10s   (ns per call)\n", "path",
+         "roundRect", "triangle", "circle", "line", "frame");
+  Adafruit_GFX &g = oled;
+  row("virtual", g);
+  row("direct", direct);
+  return 0;
+}
@@ -0,0 +1,65 @@
+// Adafruit_GrayOLED span fills against the per-pixel path they replaced,
+// at 1 and 4 bpp on a 128x128 panel. "pixels" is the old cost: the base
+// Adafruit_GFX lines (one drawPixel() per pixel) and a drawPixel() loop for
+// rectangles. Lengths and rectangle sizes are random, 1-64 px.
+#include "bench.h"
+#include <Adafruit_GrayOLED.h>
+
+#define N 1024
+
+class Panel : public Adafruit_GrayOLED {
+public:
+  Panel(uint8_t bpp) : Adafruit_GrayOLED(bpp, 128, 128) { _init(0x3C, false); }
+  void display(void) {}
+};
+
+static int16_t xs[N], ys[N], ws[N], hs[N];
+static uint16_t cs[N];
+
+static void run(uint8_t bpp) {
+  Panel oled(bpp);
+  Adafruit_GFX &g = oled;
+  for (int i = 0; i < N; i++) {
+    xs[i] = benchRand() % 128;
+    ys[i] = benchRand() % 128;
+    ws[i] = 1 + benchRand() % 64;
+    hs[i] = 1 + benchRand() % 64;
+    cs[i] = (bpp == 1) ? benchRand() % 3 : benchRand() % 16;
+  }
+  double hs_ = benchNs([&] {
+    for (int i = 0; i < N; i++)
+      g.drawFastHLine(xs[i], ys[i], ws[i], cs[i]);
+  }, N);
+  double hp = benchNs([&] {
+    for (int i = 0; i < N; i++)
+      g.Adafruit_GFX::drawFastHLine(xs[i], ys[i], ws[i], cs[i]);
+  }, N);
+  double vs = benchNs([&] {
+    for (int i = 0; i < N; i++)
+      g.drawFastVLine(xs[i], ys[i], hs[i], cs[i]);
+  }, N);
+  double vp = benchNs([&] {
+    for (int i = 0; i < N; i++)
+      g.Adafruit_GFX::drawFastVLine(xs[i], ys[i], hs[i], cs[i]);
+  }, N);
+  double rs = benchNs([&] {
+    for (int i = 0; i < N; i++)
+      g.fillRect(xs[i], ys[i], ws[i], hs[i], cs[i]);
+  }, N);
+  double rp = benchNs([&] {
+    for (int i = 0; i < N; i++)
+      for (int16_t y = ys[i]; y < ys[i] + hs[i]; y++)
+        for (int16_t x = xs[i]; x < xs[i] + ws[i]; x++)
+          g.drawPixel(x, y, cs[i]);
+  }, N);
+  printf("%d bpp  %-7s %10.1f %10.1f %10.1f\n", bpp, "spans", hs_, vs, rs);
+  printf("%d bpp  %-7s %10.1f %10.1f %10.1f\n", bpp, "pixels", hp, vp, rp);
+}
+
+int main() {
+  printf("%-14s %10s %10s %10s   (ns per call)\n", "path", "HLine", "VLine",
+         "fillRect");
+  run(1);
+  run(4);
+  return 0;
+}
@@ -0,0 +1,70 @@
+// Host stand-in for the Arduino core, just enough to build the display
+// libraries for the benchmarks and tests in this directory. Pins, time and
+// buses do nothing unless a test sets them up to (see host.cpp). The
+// Makefile defines ESP32 so the libraries take the same code paths as on
+// the target.
+#pragma once
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <string>
+
+#include "pgmspace.h"
+#define IRAM_ATTR
+
+typedef bool boolean;
+typedef uint8_t byte;
+
+#define HIGH 1
+#define LOW 0
+#define INPUT 0
+#define OUTPUT 1
+#define INPUT_PULLUP 2
+#define MSBFIRST 1
+#define LSBFIRST 0
+#define DEC 10
+#define HEX 16
+
+using std::max;
+using std::min;
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+void yield();
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t val);
+int digitalRead(uint8_t pin);
+
+// in host.cpp: the host clock, and the I2C line model behind the pin calls
+extern unsigned long host_us;
+extern int host_sda_held, host_scl_pulses, host_stops;
+
+extern volatile uint32_t host_gpio[64];
+#define digitalPinToPort(p) (p)
+#define digitalPinToBitMask(p) (1u << ((p) & 31))
+#define portOutputRegister(p) (&host_gpio[(p) & 63])
+#define portInputRegister(p) (&host_gpio[(p) & 63])
+#define portModeRegister(p) (&host_gpio[(p) & 63])
+
+static const uint8_t SDA = 21;
+static const uint8_t SCL = 22;
+
+class __FlashStringHelper;
+#define F(s) ((const __FlashStringHelper *)(s))
+
+class String {
+public:
+  String(const char *c = "") : s(c) {}
+  unsigned length() const { return s.size(); }
+  const char *c_str() const { return s.c_str(); }
+
+private:
+  std::string s;
+};
+
+#include "Print.h"
@@ -0,0 +1,19 @@
+// Host stand-in for the Arduino Print class (see Arduino.h)
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+class Print {
+public:
+  virtual ~Print() {}
+  virtual size_t write(uint8_t) = 0;
+  virtual size_t write(const uint8_t *b, size_t n) {
+    size_t r = 0;
+    while (n--)
+      r += write(*b++);
+    return r;
+  }
+  size_t write(const char *s) { return write((const uint8_t *)s, strlen(s)); }
+  size_t print(const char *s) { return write(s); }
+};
@@ -0,0 +1,69 @@
+// Host stand-in for the Arduino SPI library: transfers go nowhere, but a
+// test can record the bytes written
+#pragma once
+#include "Arduino.h"
+#include <vector>
+
+#define SPI_MODE0 0
+#define SPI_MODE1 1
+#define SPI_MODE2 2
+#define SPI_MODE3 3
+#define SPI_CLOCK_DIV2 2
+#define SPI_MSBFIRST 1
+#define SPI_LSBFIRST 0
+
+struct SPISettings {
+  SPISettings() {}
+  SPISettings(uint32_t, uint8_t, uint8_t) {}
+};
+
+class SPIClass {
+public:
+  void begin() {}
+  void begin(int, int, int, int) {}
+  void end() {}
+  void beginTransaction(SPISettings) {}
+  void endTransaction() {}
+  uint8_t transfer(uint8_t d) {
+    write(d);
+    return d;
+  }
+  void transfer(void *b, size_t n) { writeBytes((const uint8_t *)b, n); }
+  uint16_t transfer16(uint16_t d) {
+    write16(d);
+    return d;
+  }
+  void write(uint8_t b) {
+    if (record)
+      bytes.push_back(b);
+  }
+  void write16(uint16_t w) {
+    write(w >> 8);
+    write(w);
+  }
+  void write32(uint32_t l) {
+    write16(l >> 16);
+    write16(l);
+  }
+  void writeBytes(const uint8_t *b, uint32_t n) {
+    if (record)
+      bytes.insert(bytes.end(), b, b + n);
+  }
+  // 16-bit pixels, sent most significant byte first
+  void writePixels(const void *p, uint32_t n) {
+    for (uint32_t i = 0; i < n / 2; i++)
+      write16(((const uint16_t *)p)[i]);
+  }
+  void transferBytes(const uint8_t *b, uint8_t *, uint32_t n) {
+    writeBytes(b, n);
+  }
+  void setClockDivider(uint8_t) {}
+  void setFrequency(uint32_t) {}
+  void setBitOrder(uint8_t) {}
+  void setDataMode(uint8_t) {}
+
+  // test hooks
+  bool record = false;        // append every byte written to bytes
+  std::vector<uint8_t> bytes; // bytes written while record was set
+};
+extern SPIClass SPI;
@@ -0,0 +1,50 @@
+// Host stand-in for the Arduino Wire library. Transactions go nowhere and
+// succeed, unless a test asks otherwise: it can record the bytes written
+// and make a range of transactions fail (see host.cpp).
+#pragma once
+#include "Arduino.h"
+#include <vector>
+
+#define I2C_BUFFER_LENGTH 128
+
+class TwoWire {
+public:
+  void begin() {}
+  void begin(int, int) {}
+  bool begin(int, int, uint32_t) { return true; }
+  void end() { ends++; }
+  void setClock(uint32_t) {}
+  uint32_t getClock() { return 100000; }
+  void setTimeOut(uint16_t ms) { timeout = ms; }
+  uint16_t getTimeOut() { return timeout; }
+  size_t getBufferSize() { return I2C_BUFFER_LENGTH; }
+  void beginTransmission(uint8_t) { transactions++; }
+  uint8_t endTransmission(bool stop = true);
+  size_t write(uint8_t b) {
+    if (record)
+      bytes.push_back(b);
+    return 1;
+  }
+  size_t write(const uint8_t *b, size_t n) {
+    if (record)
+      bytes.insert(bytes.end(), b, b + n);
+    return n;
+  }
+  uint8_t requestFrom(uint8_t, size_t n, bool = true) { return n; }
+  int available() { return 0; }
+  int read() { return 0; }
+
+  // test hooks
+  bool record = false;        // append every byte written to bytes
+  std::vector<uint8_t> bytes; // bytes written while record was set
+  long transactions = 0;      // beginTransmission() calls so far
+  long ends = 0;              // end() calls so far
+  uint16_t timeout = 50;      // last setTimeOut(), in ms
+  // transactions failFrom to failFrom + failCount - 1 (numbered from 0 by
+  // transactions; failCount < 0 for all from failFrom on) end with status
+  // 5, after the timeout has passed on the host clock
+  long failFrom = -1, failCount = 0;
+  // host clock time each endTransmission() takes, in us
+  unsigned long transactionUs = 0;
+};
+extern TwoWire Wire;
@@ -0,0 +1,56 @@
+// Definitions behind the host stand-ins in this directory. Time only moves
+// when asked to, so nothing in the libraries waits.
+#include "Arduino.h"
+#include "SPI.h"
+#include "Wire.h"
+
+volatile uint32_t host_gpio[64];
+SPIClass SPI;
+TwoWire Wire;
+
+unsigned long host_us;
+int host_sda_held, host_scl_pulses, host_stops;
+
+static bool sdaDriven;
+
+unsigned long millis() { return host_us / 1000; }
+unsigned long micros() { return host_us; }
+void delay(unsigned long ms) { host_us += ms * 1000; }
+void delayMicroseconds(unsigned int us) { host_us += us; }
+void yield() {}
+
+// SCL and SDA model a device holding SDA low: each SCL pulse (low, then
+// released) takes one off host_sda_held. A STOP is SDA driven low, then
+// released.
+void pinMode(uint8_t pin, uint8_t mode) {
+  if ((pin == SCL) && (mode == INPUT_PULLUP) && (host_sda_held > 0))
+    host_sda_held--;
+  if (pin == SDA) {
+    if (mode == OUTPUT) {
+      sdaDriven = true;
+    } else if (sdaDriven) {
+      sdaDriven = false;
+      host_stops++;
+    }
+  }
+}
+
+void digitalWrite(uint8_t pin, uint8_t val) {
+  if ((pin == SCL) && (val == LOW))
+    host_scl_pulses++;
+}
+
+int digitalRead(uint8_t pin) {
+  return ((pin == SDA) && (host_sda_held > 0)) ? LOW : HIGH;
+}
+
+uint8_t TwoWire::endTransmission(bool) {
+  long n = transactions - 1;
+  host_us += transactionUs;
+  if ((failFrom >= 0) && (n >= failFrom) &&
+      ((failCount < 0) || (n < failFrom + failCount))) {
+    host_us += timeout * 1000UL;
+    return 5; // timeout
+  }
+  return 0;
+}
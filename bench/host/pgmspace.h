@@ -0,0 +1,9 @@
+// Host stand-in for pgmspace.h: flash is ordinary memory
+#pragma once
+#include <string.h>
+
+#define PROGMEM
+#define pgm_read_byte(addr) (*(const unsigned char *)(addr))
+#define pgm_read_word(addr) (*(const unsigned short *)(addr))
+#define pgm_read_dword(addr) (*(const unsigned long *)(addr))
+#define memcpy_P memcpy
@@ -0,0 +1,139 @@
+// Adafruit_SH1106_Band against Adafruit_SH1106 with a full framebuffer:
+// the same scene drawn into each, and the I2C bytes their display() sends
+// recorded and compared. Scenes are 60 random primitives (fills, lines,
+// circles, rounded rects, triangles, bitmaps and text, in all three
+// colors and four rotations, with clip rects and clears), lines and fills
+// with endpoints thousands of pixels off-screen, and RoboEyes-style frames
+// drawn through Adafruit_GFX_Direct. Each is drawn with band lists of 1,
+// 3, 16, 64 and 4096 entries, so that both the recorded path and the
+// overflow to a framebuffer are covered. Exits non-zero on any mismatch.
+#include <Adafruit_SH1106.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+template <class G> static void scene(G &d, int seed, int rot) {
+  srand(seed);
+  d.setRotation(rot);
+  if (seed % 3 == 1)
+    d.fillScreen(WHITE);
+  for (int i = 0; i < 60; i++) {
+    if ((seed % 2) && (rand() % 8 == 0)) {
+      if (rand() % 3)
+        d.setClipRect(rand() % 140 - 10, rand() % 80 - 10, rand() % 100,
+                      rand() % 60);
+      else
+        d.resetClipRect();
+    }
+    if ((seed % 2) && (rand() % 25 == 0))
+      d.fillScreen(rand() % 3);
+    if ((seed % 2) && (rand() % 60 == 0))
+      d.clearDisplay();
+    int x = rand() % 160 - 16, y = rand() % 96 - 16;
+    int w = rand() % 70 - 5, h = rand() % 50 - 5, c = rand() % 3;
+    static const uint8_t bitmap[] = {0xF0, 0x0F, 0xAA, 0x55, 0x3C,
+                                     0xC3, 0xFF, 0x81, 0x18, 0x7E};
+    switch (rand() % 10) {
+    case 0:
+      d.fillRect(x, y, w, h, c);
+      break;
+    case 1:
+      d.drawFastHLine(x, y, w, c);
+      break;
+    case 2:
+      d.drawFastVLine(x, y, h, c);
+      break;
+    case 3:
+      d.drawPixel(x, y, c);
+      break;
+    case 4:
+      d.fillCircle(x, y, w & 15, c);
+      break;
+    case 5:
+      d.drawLine(x, y, w, h, c);
+      break;
+    case 6:
+      d.drawBitmap(x, y, bitmap, 16, 5, c & 1, !(c & 1));
+      break;
+    case 7:
+      d.fillRoundRect(x, y, w, h, w & 7, c);
+      break;
+    case 8:
+      d.fillTriangle(x, y, x + w, y + h / 2, x - w / 3, y + h, c);
+      break;
+    case 9:
+      d.setCursor(x, y);
+      d.setTextColor(c & 1, !(c & 1));
+      d.print("Ab1");
+      break;
+    }
+  }
+  if (seed % 5 == 3) { // beyond the recorder's 12-bit fields
+    d.drawLine(-3000, 10, 3000, 40, WHITE);
+    d.fillTriangle(-4000, 0, 60, 5000, 100, -2500, INVERSE);
+    d.fillRect(-5000, 20, 5060, 9, INVERSE);
+    d.fillCircle(64, -2100, 2130, INVERSE);
+  }
+  if (seed % 4 == 2)
+    d.fillScreen(INVERSE);
+}
+
+// the primitives RoboEyes draws, through Adafruit_GFX_Direct as it does
+template <class G> static void eyes(G &d, int seed) {
+  Adafruit_GFX_Direct<G> g(d);
+  srand(seed);
+  d.clearDisplay();
+  for (int i = 0; i < 12; i++) {
+    int x = rand() % 128, y = rand() % 64;
+    int w = rand() % 50, h = rand() % 40, c = rand() % 3;
+    g.fillRoundRect(x, y, w, h, w / 4, c);
+    g.fillTriangle(x, y, x + w, y, x, y + h, !c);
+    g.drawLine(x, y, y, x, c);
+    g.fillCircle(x, y, h / 5, c);
+    g.drawPixel(y, x, c);
+  }
+}
+
+int main() {
+  static const uint16_t caps[] = {1, 3, 16, 64, 4096};
+  SH1106_Panel bare = {SH1106_LCDWIDTH, SH1106_LCDHEIGHT, SH1106_COLUMN_OFFSET,
+                       NULL, NULL};
+  int bad = 0, cases = 0;
+  Wire.record = true;
+  for (uint16_t cap : caps) {
+    for (int k = 0; k < 40; k++) {
+      for (int mode = 0; mode < 2; mode++) {
+        Adafruit_SH1106 full(21, 22);
+        full.begin(SH1106_SWITCHCAPVCC, 0x3C, false);
+        full.clearDisplay();
+        Wire.bytes.clear();
+        if (mode)
+          eyes(full, k);
+        else
+          scene(full, k, k & 3);
+        full.display();
+        std::vector<uint8_t> want = Wire.bytes;
+
+        Adafruit_SH1106 oled(bare, 21, 22);
+        oled.begin(SH1106_SWITCHCAPVCC, 0x3C, false);
+        Adafruit_SH1106_Band band(oled, cap);
+        band.begin();
+        Wire.bytes.clear();
+        if (mode)
+          eyes(band, k);
+        else
+          scene(band, k, k & 3);
+        band.display();
+
+        cases++;
+        if (Wire.bytes != want) {
+          printf("%s %d, %u entries: %zu bytes sent, %zu expected\n",
+                 mode ? "eyes" : "scene", k, cap, Wire.bytes.size(),
+                 want.size());
+          bad++;
+        }
+      }
+    }
+  }
+  printf("sh1106_band_fuzz: %d cases, %d differ\n", cases, bad);
+  return bad ? 1 : 0;
+}
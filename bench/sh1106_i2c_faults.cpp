@@ -0,0 +1,110 @@
+// Adafruit_SH1106 I2C error handling against a Wire that fails chosen
+// transactions (see host/Wire.h). Each transaction takes 1 ms of host time
+// and a failed one the whole timeout on top. Checks that:
+// - a failed transaction aborts the frame and its Wire status is kept, and
+//   the bus clear that follows sends 9 SCL pulses and a STOP while a device
+//   holds SDA low
+// - the next display() repaints every page, and the one after sends nothing
+// - with the panel gone, no display() call blocks for more than about two
+//   timeouts
+// - once the panel is back, the next display() re-initialises it and
+//   repaints it
+// - contrast, start line and inversion survive the re-init
+// Exits non-zero if any check fails.
+#include "bench.h"
+#include <Adafruit_SH1106.h>
+
+static int bad;
+
+static void check(bool ok, const char *what) {
+  if (!ok) {
+    printf("sh1106_i2c_faults: %s\n", what);
+    bad++;
+  }
+}
+
+int main() {
+  Adafruit_SH1106 d(21, 22);
+  Wire.transactionUs = 1000;
+  d.begin(SH1106_SWITCHCAPVCC, 0x3C, false);
+  check(Wire.timeout == SH1106_I2C_TIMEOUT_MS, "Wire timeout not set");
+  d.clearDisplay();
+  d.display();
+  check(d.busOK() && !d.getI2CErrors(), "errors on a healthy bus");
+
+  // a glitch mid-frame: one transaction fails, and a device holds SDA
+  d.fillRect(0, 0, 128, 64, WHITE);
+  Wire.failFrom = Wire.transactions + 10;
+  Wire.failCount = 1;
+  host_sda_held = 100;
+  d.display();
+  check(d.getI2CErrors() == 1, "glitch: error not counted");
+  check(d.getLastI2CError() == 5, "glitch: Wire's timeout status not kept");
+  check(d.getBusRecoveries() == 1, "glitch: no bus recovery");
+  check(d.busOK(), "glitch: bus not usable after recovery");
+  check(host_scl_pulses == 9, "glitch: bus clear didn't send 9 SCL pulses");
+  check(host_stops == 1, "glitch: bus clear didn't end with a STOP");
+
+  // the aborted frame is repainted in full, though nothing changed since
+  long t = Wire.transactions;
+  d.display();
+  check(Wire.transactions - t == 72, "no full repaint after the glitch");
+  t = Wire.transactions;
+  d.display();
+  check(Wire.transactions == t, "repaint repeated with nothing dirty");
+
+  // panel gone: every transaction fails
+  Wire.failFrom = Wire.transactions;
+  Wire.failCount = -1;
+  unsigned long worst = 0;
+  for (int f = 0; f < 60; f++) {
+    d.drawPixel(f, f, INVERSE);
+    unsigned long t0 = host_us;
+    d.display();
+    worst = max(worst, (host_us - t0) / 1000);
+    d.setContrast(f);
+    host_us += 16000; // one 60 fps frame
+  }
+  printf("panel gone: %u errors, %u recoveries, longest display() %lu ms\n",
+         (unsigned)d.getI2CErrors(), (unsigned)d.getBusRecoveries(), worst);
+  check(worst <= 2 * (SH1106_I2C_TIMEOUT_MS + 1) + 1,
+        "panel gone: display() blocked too long");
+
+  // panel back: re-init (one transaction) and a full repaint
+  Wire.failFrom = -1;
+  host_us += 200000;
+  t = Wire.transactions;
+  d.display();
+  check(d.busOK(), "panel back: bus not usable");
+  check(Wire.transactions - t == 73, "panel back: no re-init and repaint");
+
+  // settings made before a recovery go out again with the re-init
+  d.setContrast(0x42);
+  d.setStartLine(70);
+  d.invertDisplay(1);
+  host_us += 200000;
+  Wire.failFrom = Wire.transactions;
+  Wire.failCount = 1;
+  Wire.bytes.clear();
+  Wire.record = true;
+  d.fillRect(0, 0, 8, 8, INVERSE);
+  d.display();
+  Wire.record = false;
+  Wire.failFrom = -1;
+  const std::vector<uint8_t> &b = Wire.bytes;
+  int contrast = 0, startLine = 0, invert = 0, normal = 0;
+  for (size_t k = 0; k < b.size(); k++) {
+    if ((b[k] == SH1106_SETCONTRAST) && (k + 1 < b.size()) && (b[k + 1] == 0x42))
+      contrast++;
+    startLine += (b[k] == (SH1106_SETSTARTLINE | (70 & 0x3F)));
+    invert += (b[k] == SH1106_INVERTDISPLAY);
+    normal += (b[k] == SH1106_NORMALDISPLAY);
+  }
+  check(d.getBusRecoveries() >= 2, "settings: no recovery ran");
+  check(contrast, "settings: contrast lost in the re-init");
+  check(startLine, "settings: start line lost in the re-init");
+  check(invert && !normal, "settings: inversion lost in the re-init");
+
+  printf("sh1106_i2c_faults: %d checks failed\n", bad);
+  return bad ? 1 : 0;
+}
@@ -0,0 +1,58 @@
+// Adafruit_SH1106 pixel and line cost per rotation, for the runtime
+// rotation build and SH1106_FIXED_ROTATION builds (see the Makefile, which
+// builds this once per variant). Calls go through Adafruit_GFX&, as they do
+// from the GFX primitives.
+#include "bench.h"
+#include <Adafruit_SH1106.h>
+
+#define N 4096
+
+static Adafruit_SH1106 oled;
+static int16_t xs[N], ys[N], ls[N];
+static uint16_t cs[N];
+
+static void run(uint8_t r) {
+  Adafruit_GFX &g = oled;
+  g.setRotation(r);
+  for (int i = 0; i < N; i++) {
+    xs[i] = benchRand() % g.width();
+    ys[i] = benchRand() % g.height();
+    ls[i] = 1 + benchRand() % 64;
+    cs[i] = benchRand() % 3; // BLACK, WHITE, INVERSE
+  }
+  double px = benchNs([&] {
+    for (int i = 0; i < N; i++)
+      g.drawPixel(xs[i], ys[i], cs[i]);
+  }, N);
+  double hl = benchNs([&] {
+    for (int i = 0; i < N; i++)
+      g.drawFastHLine(xs[i], ys[i], ls[i], cs[i]);
+  }, N);
+  double vl = benchNs([&] {
+    for (int i = 0; i < N; i++)
+      g.drawFastVLine(xs[i], ys[i], ls[i], cs[i]);
+  }, N);
+#if defined(SH1106_FIXED_PANEL) && defined(SH1106_FIXED_ROTATION)
+  const char *variant = "panel+fixed";
+#elif defined(SH1106_FIXED_PANEL)
+  const char *variant = "panel";
+#elif defined(SH1106_FIXED_ROTATION)
+  const char *variant = "fixed";
+#else
+  const char *variant = "runtime";
+#endif
+  printf("%-11s %5d %12.2f %12.2f %12.2f\n", variant, g.getRotation(), px, hl,
+         vl);
+}
+
+int main() {
+  printf("%-11s %5s %12s %12s %12s   (ns per call, lines 1-64 px)\n",
+         "build", "rotation", "drawPixel", "HLine", "VLine");
+#ifdef SH1106_FIXED_ROTATION
+  run(SH1106_FIXED_ROTATION);
+#else
+  for (uint8_t r = 0; r < 4; r++)
+    run(r);
+#endif
+  return 0;
+}
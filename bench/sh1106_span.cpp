@@ -0,0 +1,63 @@
+// Adafruit_SH1106 page span writers per span length, against the byte loop
+// they replaced, and fillRect() against one vertical line per column. The
+// driver source is included rather than linked so that the file-local
+// fillSpan() can be timed on its own. Spans start at random columns (so at
+// every word alignment) with a random single-row mask and color.
+#include "bench.h"
+#include "Adafruit_SH1106.cpp"
+
+#define N 1024
+
+// the per-column loop drawFastHLineInternal() used before the span writers
+static void byteSpan(uint8_t *d, int16_t n, uint8_t m, uint16_t color) {
+  switch (color) {
+  case WHITE:
+    while (n--)
+      *d++ |= m;
+    break;
+  case BLACK:
+    m = ~m;
+    while (n--)
+      *d++ &= m;
+    break;
+  case INVERSE:
+    while (n--)
+      *d++ ^= m;
+    break;
+  }
+}
+
+static Adafruit_SH1106 oled;
+static uint8_t buf[8 * 128 + 128];
+static int16_t xs[N];
+static uint8_t ms[N];
+static uint16_t cs[N];
+
+int main() {
+  for (int i = 0; i < N; i++) {
+    xs[i] = benchRand() % (sizeof(buf) - 128);
+    ms[i] = 1 << (benchRand() % 8);
+    cs[i] = benchRand() % 3;
+  }
+  printf("%-8s %12s %12s   (ns per span)\n", "length", "fillSpan", "byte loop");
+  static const int16_t lens[] = {1, 2, 4, 8, 16, 32, 64, 128};
+  for (int16_t n : lens) {
+    double span = benchNs([&] {
+      for (int i = 0; i < N; i++)
+        fillSpan(&buf[xs[i]], n, ms[i], cs[i]);
+    }, N);
+    double byte = benchNs([&] {
+      for (int i = 0; i < N; i++)
+        byteSpan(&buf[xs[i]], n, ms[i], cs[i]);
+    }, N);
+    printf("%-8d %12.1f %12.1f\n", n, span, byte);
+  }
+
+  Adafruit_GFX &g = oled;
+  double rect = benchNs([&] { g.fillRect(30, 11, 60, 40, INVERSE); }, 1);
+  double cols = benchNs([&] {
+    g.Adafruit_GFX::fillRect(30, 11, 60, 40, INVERSE);
+  }, 1);
+  printf("\nfillRect 60x40: %.1f ns, per column: %.1f ns\n", rect, cols);
+  return 0;
+}
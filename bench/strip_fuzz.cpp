@@ -0,0 +1,133 @@
+// Adafruit_SPITFT_Strip against a GFXcanvas16: 3000 random scenes of up to
+// 40 primitives, drawn into both through Adafruit_GFX_Direct and the
+// virtual calls, with random clip rects and clears, on random screen and
+// strip sizes. The strip's display() goes out over the host SPI, where the
+// pixels are recorded and compared with the canvas. The list is kept short
+// (4 entries to start with) so it regrows along the way. Exits non-zero on
+// any pixel difference.
+#include <Adafruit_SPITFT_Strip.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+// a panel whose commands go nowhere, so the SPI carries only pixels
+class HostTFT : public Adafruit_SPITFT {
+public:
+  HostTFT(uint16_t w, uint16_t h) : Adafruit_SPITFT(w, h, 5, 16) {}
+  void begin(uint32_t freq) { initSPI(freq); }
+  void setAddrWindow(uint16_t, uint16_t, uint16_t, uint16_t) {}
+};
+
+int main() {
+  long bad = 0;
+  srand(6);
+  for (int it = 0; it < 3000; it++) {
+    int W = 8 + rand() % 120, H = 8 + rand() % 120, SH = 1 + rand() % 20;
+    HostTFT tft(W, H);
+    tft.begin(0);
+    Adafruit_SPITFT_Strip s(&tft, W, H, SH, 4);
+    if (!s.begin()) {
+      printf("strip_fuzz: out of memory\n");
+      return 1;
+    }
+    GFXcanvas16 ref(W, H);
+    Adafruit_GFX_Direct<Adafruit_SPITFT_Strip> g(s);
+
+    uint16_t bg = rand();
+    s.fillScreen(bg);
+    ref.fillScreen(bg);
+    int n = rand() % 40;
+    for (int k = 0; k < n; k++) {
+      int x = rand() % (W + 40) - 20, y = rand() % (H + 40) - 20;
+      int w = rand() % 60 - 10, h = rand() % 60 - 10;
+      int c = rand(), r = rand() % 15;
+      if (rand() % 6 == 0) {
+        int cx = rand() % (W + 20) - 10, cy = rand() % (H + 20) - 10;
+        int cw = rand() % W, ch = rand() % H;
+        if (rand() % 3) {
+          s.setClipRect(cx, cy, cw, ch);
+          ref.setClipRect(cx, cy, cw, ch);
+        } else {
+          s.resetClipRect();
+          ref.resetClipRect();
+        }
+      }
+      if (rand() % 30 == 0) {
+        uint16_t f = rand();
+        s.fillScreen(f);
+        ref.fillScreen(f);
+      }
+      switch (rand() % 10) {
+      case 0:
+        g.fillRect(x, y, abs(w), h, c);
+        ref.fillRect(x, y, abs(w), h, c);
+        break;
+      case 1:
+        g.drawFastHLine(x, y, w, c);
+        ref.drawFastHLine(x, y, w, c);
+        break;
+      case 2:
+        g.drawFastVLine(x, y, h, c);
+        ref.drawFastVLine(x, y, h, c);
+        break;
+      case 3:
+        if ((w > 0) && (h > 0)) {
+          g.fillRoundRect(x, y, w, h, r, c);
+          ref.fillRoundRect(x, y, w, h, r, c);
+        }
+        break;
+      case 4:
+        g.fillCircle(x, y, r, c);
+        ref.fillCircle(x, y, r, c);
+        break;
+      case 5:
+        g.fillTriangle(x, y, x + w, y + r, x - r, y + h, c);
+        ref.fillTriangle(x, y, x + w, y + r, x - r, y + h, c);
+        break;
+      case 6:
+        g.drawLine(x, y, x + w, y + h, c);
+        ref.drawLine(x, y, x + w, y + h, c);
+        break;
+      case 7:
+        g.drawPixel(x, y, c);
+        ref.drawPixel(x, y, c);
+        break;
+      case 8:
+        s.drawCircle(x, y, r, c);
+        ref.drawCircle(x, y, r, c);
+        break;
+      case 9:
+        s.setCursor(x, y);
+        ref.setCursor(x, y);
+        s.setTextColor(c);
+        ref.setTextColor(c);
+        s.print("Hi!");
+        ref.print("Hi!");
+        break;
+      }
+    }
+
+    SPI.bytes.clear();
+    SPI.record = true;
+    s.display();
+    SPI.record = false;
+    const uint16_t *want = ref.getBuffer();
+    if (SPI.bytes.size() != (size_t)W * H * 2) {
+      printf("scene %d: %zu bytes sent for %dx%d\n", it, SPI.bytes.size(), W,
+             H);
+      bad++;
+      continue;
+    }
+    for (int i = 0; i < W * H; i++) {
+      uint16_t got = (SPI.bytes[2 * i] << 8) | SPI.bytes[2 * i + 1];
+      if (got != want[i]) {
+        if (bad < 5)
+          printf("scene %d %dx%d strip %d: pixel %d,%d is %04X, not %04X\n",
+                 it, W, H, SH, i % W, i / W, got, want[i]);
+        bad++;
+        break;
+      }
+    }
+  }
+  printf("strip_fuzz: 3000 scenes, %ld differ\n", bad);
+  return bad ? 1 : 0;
+}
@@ -0,0 +1,69 @@
+// GFXtranspose8x8() and the row/page 1-bpp converters built on it, in MB/s
+// of 1-bpp image moved. "per-pixel" is the loop they replace: one bit read
+// and one bit written per pixel. The whole-buffer figures are for a 128x64
+// image (1 KB); "rect" copies an unaligned 61x37 rectangle of it.
+#include "bench.h"
+#include <Adafruit_GFX.h>
+#include <string.h>
+
+#define W 128
+#define H 64
+#define BYTES (W * H / 8)
+#define TILES 1024
+
+static uint8_t rows[BYTES], pages[BYTES];
+static uint64_t tiles[TILES], out[TILES];
+
+static void perPixelRowsToPages(void) {
+  for (int16_t y = 0; y < H; y++)
+    for (int16_t x = 0; x < W; x++) {
+      uint8_t m = 1 << (y & 7), *p = &pages[x + (y / 8) * W];
+      if (rows[y * (W / 8) + x / 8] & (0x80 >> (x & 7)))
+        *p |= m;
+      else
+        *p &= ~m;
+    }
+}
+
+static void perPixelPagesToRows(void) {
+  for (int16_t y = 0; y < H; y++)
+    for (int16_t x = 0; x < W; x++) {
+      uint8_t m = 0x80 >> (x & 7), *p = &rows[y * (W / 8) + x / 8];
+      if (pages[x + (y / 8) * W] & (1 << (y & 7)))
+        *p |= m;
+      else
+        *p &= ~m;
+    }
+}
+
+int main() {
+  for (int i = 0; i < BYTES; i++)
+    rows[i] = pages[i] = benchRand();
+  for (int i = 0; i < TILES; i++)
+    tiles[i] = ((uint64_t)benchRand() << 32) | benchRand();
+
+  double kernel = benchMBs([] {
+    for (int i = 0; i < TILES; i++)
+      out[i] = GFXtranspose8x8(tiles[i]);
+    __asm__ __volatile__("" : : "r"(out) : "memory");
+  }, TILES * 8);
+  double r2p = benchMBs([] { GFXrowsToPages(rows, pages, W, H); }, BYTES);
+  double p2r = benchMBs([] { GFXpagesToRows(pages, rows, W, H); }, BYTES);
+  double r2pRect = benchMBs([] {
+    GFXrowsToPages(rows, W / 8, 3, 5, 61, 37, pages, W, 9, 2);
+  }, 61 * 37 / 8);
+  double p2rRect = benchMBs([] {
+    GFXpagesToRows(pages, W, 3, 5, 61, 37, rows, W / 8, 9, 2);
+  }, 61 * 37 / 8);
+  double r2pPixel = benchMBs(perPixelRowsToPages, BYTES);
+  double p2rPixel = benchMBs(perPixelPagesToRows, BYTES);
+
+  printf("%-16s %12s %12s %12s   (MB/s)\n", "", "whole", "rect",
+         "per-pixel");
+  printf("%-16s %12.0f\n", "GFXtranspose8x8", kernel);
+  printf("%-16s %12.0f %12.0f %12.0f\n", "rowsToPages", r2p, r2pRect,
+         r2pPixel);
+  printf("%-16s %12.0f %12.0f %12.0f\n", "pagesToRows", p2r, p2rRect,
+         p2rPixel);
+  return 0;
+}
@@ -35,9 +35,33 @@ All text above, and the splash screen below must be included in any redistributi
 #include "Adafruit_GFX.h"
 #include "Adafruit_SH1106.h"
 
-// the memory buffer for the LCD
+#ifdef SH1106_CLOCK_TUNING
+ #include <Preferences.h>
+#endif
+
+// addressing commands for page i: the page, then the panel's first RAM
+// column (low and high nibble)
+#define SH1106_PAGE_CMD(i) { (uint8_t)(0xB0 + (i)), (uint8_t)(colOffset & 0x0F), \
+                             (uint8_t)(SH1106_SETHIGHCOLUMN | (colOffset >> 4)) }
+
+// size of the Wire library's transmit buffer, control byte included
+#if defined(I2C_BUFFER_LENGTH)
+  #define SH1106_WIRE_MAX I2C_BUFFER_LENGTH
+#elif defined(BUFFER_LENGTH)
+  #define SH1106_WIRE_MAX BUFFER_LENGTH
+#else
+  #define SH1106_WIRE_MAX 32
+#endif
 
-static uint8_t buffer[SH1106_LCDHEIGHT * SH1106_LCDWIDTH / 8] = { 
+// the memory buffer for the LCD selected in Adafruit_SH1106.h, used by the
+// constructors without an SH1106_Panel. Zero-initialised (.bss), so startup
+// has nothing to copy into it; begin() loads the splash screen unless
+// SH1106_NO_SPLASH is defined
+static uint8_t sh1106_buffer[SH1106_LCDHEIGHT * SH1106_LCDWIDTH / 8];
+
+#ifndef SH1106_NO_SPLASH
+// the splash screen, kept in flash
+static const uint8_t splash[SH1106_LCDHEIGHT * SH1106_LCDWIDTH / 8] PROGMEM = { 
 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
@@ -107,78 +131,171 @@ static uint8_t buffer[SH1106_LCDHEIGHT * SH1106_LCDWIDTH / 8] = {
 #endif
 #endif
 };
+#endif
+
+#ifdef SH1106_SHADOW_BUFFER
+// copy of sh1106_buffer as last sent, see changedPages()
+static uint8_t sh1106_shown[SH1106_LCDHEIGHT * SH1106_LCDWIDTH / 8];
+#else
+#define sh1106_shown NULL
+#endif
+
+static SH1106_Panel defaultPanel(void) {
+  SH1106_Panel p = { SH1106_LCDWIDTH, SH1106_LCDHEIGHT, SH1106_COLUMN_OFFSET, sh1106_buffer, sh1106_shown };
+  return p;
+}
 
 #define swap(a, b) { int16_t t = a; a = b; b = t; }
 
-// the most basic function, set a single pixel
+// panel size as seen by the driver. With SH1106_FIXED_PANEL it is the one
+// selected in Adafruit_SH1106.h, a constant, so bounds checks, page loops
+// and buffer offsets fold to constants too; otherwise it is read from the
+// object.
+#ifdef SH1106_FIXED_PANEL
+  #define SH1106_PANEL_WIDTH  ((int16_t)SH1106_LCDWIDTH)
+  #define SH1106_PANEL_HEIGHT ((int16_t)SH1106_LCDHEIGHT)
+#else
+  #define SH1106_PANEL_WIDTH  WIDTH
+  #define SH1106_PANEL_HEIGHT HEIGHT
+#endif
+
+// rotation and rotated size as seen by the pixel and line primitives. With
+// SH1106_FIXED_ROTATION the rotation is a constant, so the rotation
+// switches below fold down to the one case that applies.
+#ifdef SH1106_FIXED_ROTATION
+  #define SH1106_ROTATION   SH1106_FIXED_ROTATION
+  #define SH1106_ROT_WIDTH  ((SH1106_FIXED_ROTATION & 1) ? SH1106_PANEL_HEIGHT : SH1106_PANEL_WIDTH)
+  #define SH1106_ROT_HEIGHT ((SH1106_FIXED_ROTATION & 1) ? SH1106_PANEL_WIDTH : SH1106_PANEL_HEIGHT)
+#else
+  #define SH1106_ROTATION   rotation
+  #define SH1106_ROT_WIDTH  _width
+  #define SH1106_ROT_HEIGHT _height
+#endif
+
+#ifdef SH1106_FIXED_ROTATION
+// the orientation is fixed at build time, whatever is asked for here
+void Adafruit_SH1106::setRotation(uint8_t r) {
+  (void)r;
+  Adafruit_GFX::setRotation(SH1106_FIXED_ROTATION);
+}
+#endif
+
+// the most basic function, set a single pixel. Without a framebuffer (a
+// panel drawn through Adafruit_SH1106_Band) drawing here does nothing
 void Adafruit_SH1106::drawPixel(int16_t x, int16_t y, uint16_t color) {
-  if ((x < 0) || (x >= width()) || (y < 0) || (y >= height()))
+  if (!buffer) return;
+  if ((x < 0) || (x >= SH1106_ROT_WIDTH) || (y < 0) || (y >= SH1106_ROT_HEIGHT) || clipped(x, y))
     return;
+  markDirty(x, y, 1, 1);
 
   // check rotation, move pixel around if necessary
-  switch (getRotation()) {
+  switch (SH1106_ROTATION) {
   case 1:
     swap(x, y);
-    x = WIDTH - x - 1;
+    x = SH1106_PANEL_WIDTH - x - 1;
     break;
   case 2:
-    x = WIDTH - x - 1;
-    y = HEIGHT - y - 1;
+    x = SH1106_PANEL_WIDTH - x - 1;
+    y = SH1106_PANEL_HEIGHT - y - 1;
     break;
   case 3:
     swap(x, y);
-    y = HEIGHT - y - 1;
+    y = SH1106_PANEL_HEIGHT - y - 1;
     break;
   }  
 
   // x is which column
     switch (color) 
     {
-      case WHITE:   buffer[x+ (y/8)*SH1106_LCDWIDTH] |=  (1 << (y&7)); break;
-      case BLACK:   buffer[x+ (y/8)*SH1106_LCDWIDTH] &= ~(1 << (y&7)); break; 
-      case INVERSE: buffer[x+ (y/8)*SH1106_LCDWIDTH] ^=  (1 << (y&7)); break; 
+      case WHITE:   buffer[x+ (y/8)*SH1106_PANEL_WIDTH] |=  (1 << (y&7)); break;
+      case BLACK:   buffer[x+ (y/8)*SH1106_PANEL_WIDTH] &= ~(1 << (y&7)); break; 
+      case INVERSE: buffer[x+ (y/8)*SH1106_PANEL_WIDTH] ^=  (1 << (y&7)); break; 
     }
     
 }
 
-Adafruit_SH1106::Adafruit_SH1106(int8_t SID, int8_t SCLK, int8_t DC, int8_t RST, int8_t CS) : Adafruit_GFX(SH1106_LCDWIDTH, SH1106_LCDHEIGHT) {
+Adafruit_SH1106::Adafruit_SH1106(int8_t SID, int8_t SCLK, int8_t DC, int8_t RST, int8_t CS) :
+  Adafruit_SH1106(defaultPanel(), SID, SCLK, DC, RST, CS) {}
+
+Adafruit_SH1106::Adafruit_SH1106(const SH1106_Panel &panel, int8_t SID, int8_t SCLK, int8_t DC, int8_t RST, int8_t CS) :
+  Adafruit_GFX(panel.width, panel.height), buffer(panel.buffer), shown(panel.shown),
+  shownValid(0), colOffset(panel.colOffset) {
   cs = CS;
   rst = RST;
   dc = DC;
   sclk = SCLK;
   sid = SID;
   hwSPI = false;
+#ifdef SH1106_FIXED_ROTATION
+  Adafruit_GFX::setRotation(SH1106_FIXED_ROTATION);
+#endif
 }
 
-// constructor for hardware SPI - we indicate DataCommand, ChipSelect, Reset 
-Adafruit_SH1106::Adafruit_SH1106(int8_t DC, int8_t RST, int8_t CS) : Adafruit_GFX(SH1106_LCDWIDTH, SH1106_LCDHEIGHT) {
+// constructor for hardware SPI - we indicate DataCommand, ChipSelect, Reset
+// and optionally the SPI clock
+Adafruit_SH1106::Adafruit_SH1106(int8_t DC, int8_t RST, int8_t CS, uint32_t freq) :
+  Adafruit_SH1106(defaultPanel(), DC, RST, CS, freq) {}
+
+Adafruit_SH1106::Adafruit_SH1106(const SH1106_Panel &panel, int8_t DC, int8_t RST, int8_t CS, uint32_t freq) :
+  Adafruit_GFX(panel.width, panel.height), buffer(panel.buffer), shown(panel.shown),
+  shownValid(0), colOffset(panel.colOffset), spiSettings(freq, MSBFIRST, SPI_MODE0) {
   dc = DC;
   rst = RST;
   cs = CS;
+  sclk = sid = -1;
   hwSPI = true;
+#ifdef SH1106_FIXED_ROTATION
+  Adafruit_GFX::setRotation(SH1106_FIXED_ROTATION);
+#endif
 }
 
 // initializer for I2C - we only indicate the reset pin!
 Adafruit_SH1106::Adafruit_SH1106(uint8_t reset) :
-Adafruit_GFX(SH1106_LCDWIDTH, SH1106_LCDHEIGHT) {
+Adafruit_GFX(SH1106_LCDWIDTH, SH1106_LCDHEIGHT), buffer(sh1106_buffer), shown(sh1106_shown),
+  shownValid(0), colOffset(SH1106_COLUMN_OFFSET) {
   sclk = dc = cs = sid = -1;
+  sda = scl = -1;
   rst = reset;
+  hwSPI = false;
+#ifdef SH1106_FIXED_ROTATION
+  Adafruit_GFX::setRotation(SH1106_FIXED_ROTATION);
+#endif
 }
 
 Adafruit_SH1106::Adafruit_SH1106(int8_t SDA, int8_t SCL) :
-Adafruit_GFX(SH1106_LCDWIDTH, SH1106_LCDHEIGHT) {
+  Adafruit_SH1106(defaultPanel(), SDA, SCL) {}
+
+Adafruit_SH1106::Adafruit_SH1106(const SH1106_Panel &panel, int8_t SDA, int8_t SCL) :
+Adafruit_GFX(panel.width, panel.height), buffer(panel.buffer), shown(panel.shown),
+  shownValid(0), colOffset(panel.colOffset) {
   sclk = dc = cs = sid = -1;
   sda = SDA;
   scl = SCL;
+  rst = -1;     // no reset pin
   hwSPI = false;
+#ifdef SH1106_FIXED_ROTATION
+  Adafruit_GFX::setRotation(SH1106_FIXED_ROTATION);
+#endif
+}
+
+Adafruit_SH1106::~Adafruit_SH1106(void) {
+  delete i2c_dev;
 }
 
 void Adafruit_SH1106::begin(uint8_t vccstate, uint8_t i2caddr, bool reset) {
   _vccstate = vccstate;
   _i2caddr = i2caddr;
+  shownValid = 0;
+  contrastLevel = getInitContrast();
+  startLine = 0;
+  inverted = false;
+#ifndef SH1106_NO_SPLASH
+  if (buffer && (SH1106_PANEL_WIDTH == SH1106_LCDWIDTH) && (SH1106_PANEL_HEIGHT == SH1106_LCDHEIGHT))
+    memcpy_P(buffer, splash, sizeof(splash));
+#endif
 
-  // set pin directions
-  if (sid != -1){
+  // set pin directions (dc is only set up for SPI, either flavour)
+  if (dc != -1){
     pinMode(dc, OUTPUT);
     pinMode(cs, OUTPUT);
     csport      = portOutputRegister(digitalPinToPort(cs));
@@ -195,30 +312,23 @@ void Adafruit_SH1106::begin(uint8_t vccstate, uint8_t i2caddr, bool reset) {
       mosipinmask = digitalPinToBitMask(sid);
       }
     if (hwSPI){
+      // clock and mode come from spiSettings with each transaction
       SPI.begin ();
-#ifdef __SAM3X8E__
-      SPI.setClockDivider (9); // 9.3 MHz
-#else
-      SPI.setClockDivider (SPI_CLOCK_DIV2); // 8 MHz
-#endif
+      *csport |= cspinmask;
       }
     }
   else
   {
-    // I2C Init
-    if(sda == -1 || scl == -1){
-    Wire.begin();
-#ifdef __SAM3X8E__
-    // Force 400 KHz I2C, rawr! (Uses pins 20, 21 for SDA, SCL)
-    TWI1->TWI_CWGR = 0;
-    TWI1->TWI_CWGR = ((VARIANT_MCK / (2 * 400000)) - 4) * 0x101;
-#endif
-    } else {
-       Wire.begin(sda, scl); 
+    // I2C Init. Commands and display data go out through BusIO, on Wire
+    if (!i2c_dev || (i2c_dev->address() != i2caddr)) {
+      delete i2c_dev;
+      i2c_dev = new Adafruit_I2CDevice(i2caddr, &Wire);
     }
+    busFailed = false;
+    beginWire();
   }
 
-  if (reset) {
+  if (reset && (rst != (uint8_t)-1)) {
     // Setup reset pin direction (used by both SPI and I2C)  
     pinMode(rst, OUTPUT);
     digitalWrite(rst, HIGH);
@@ -233,119 +343,227 @@ void Adafruit_SH1106::begin(uint8_t vccstate, uint8_t i2caddr, bool reset) {
     // turn on VCC (9V?)
   }
 
-   #if defined SH1106_128_32
-    // Init sequence for 128x32 OLED module
-    sh1106_command(SH1106_DISPLAYOFF);                    // 0xAE
-    sh1106_command(SH1106_SETDISPLAYCLOCKDIV);            // 0xD5
-    sh1106_command(0x80);                                  // the suggested ratio 0x80
-    sh1106_command(SH1106_SETMULTIPLEX);                  // 0xA8
-    sh1106_command(0x1F);
-    sh1106_command(SH1106_SETDISPLAYOFFSET);              // 0xD3
-    sh1106_command(0x0);                                   // no offset
-    sh1106_command(SH1106_SETSTARTLINE | 0x0);            // line #0
-    sh1106_command(SH1106_CHARGEPUMP);                    // 0x8D
-    if (vccstate == SH1106_EXTERNALVCC) 
-      { sh1106_command(0x10); }
-    else 
-      { sh1106_command(0x14); }
-    sh1106_command(SH1106_MEMORYMODE);                    // 0x20
-    sh1106_command(0x00);                                  // 0x0 act like ks0108
-    sh1106_command(SH1106_SEGREMAP | 0x1);
-    sh1106_command(SH1106_COMSCANDEC);
-    sh1106_command(SH1106_SETCOMPINS);                    // 0xDA
-    sh1106_command(0x02);
-    sh1106_command(SH1106_SETCONTRAST);                   // 0x81
-    sh1106_command(0x8F);
-    sh1106_command(SH1106_SETPRECHARGE);                  // 0xd9
-    if (vccstate == SH1106_EXTERNALVCC) 
-      { sh1106_command(0x22); }
-    else 
-      { sh1106_command(0xF1); }
-    sh1106_command(SH1106_SETVCOMDETECT);                 // 0xDB
-    sh1106_command(0x40);
-    sh1106_command(SH1106_DISPLAYALLON_RESUME);           // 0xA4
-    sh1106_command(SH1106_NORMALDISPLAY);                 // 0xA6
-  #endif
-
-  #if defined SH1106_128_64
-    // Init sequence for 128x64 OLED module
-    sh1106_command(SH1106_DISPLAYOFF);                    // 0xAE
-    sh1106_command(SH1106_SETDISPLAYCLOCKDIV);            // 0xD5
-    sh1106_command(0x80);                                  // the suggested ratio 0x80
-    sh1106_command(SH1106_SETMULTIPLEX);                  // 0xA8
-    sh1106_command(0x3F);
-    sh1106_command(SH1106_SETDISPLAYOFFSET);              // 0xD3
-    sh1106_command(0x0);                                   // no offset
-    sh1106_command(SH1106_SETSTARTLINE | 0x0);            // line #0
-    sh1106_command(SH1106_CHARGEPUMP);                    // 0x8D
-    if (vccstate == SH1106_EXTERNALVCC) 
-      { sh1106_command(0x10); }
-    else 
-      { sh1106_command(0x14); }
-    sh1106_command(SH1106_MEMORYMODE);                    // 0x20
-    sh1106_command(0x00);                                  // 0x0 act like ks0108
-    sh1106_command(SH1106_SEGREMAP | 0x1);
-    sh1106_command(SH1106_COMSCANDEC);
-    sh1106_command(SH1106_SETCOMPINS);                    // 0xDA
-    sh1106_command(0x12);
-    sh1106_command(SH1106_SETCONTRAST);                   // 0x81
-    if (vccstate == SH1106_EXTERNALVCC) 
-      { sh1106_command(0x9F); }
-    else 
-      { sh1106_command(0xCF); }
-    sh1106_command(SH1106_SETPRECHARGE);                  // 0xd9
-    if (vccstate == SH1106_EXTERNALVCC) 
-      { sh1106_command(0x22); }
-    else 
-      { sh1106_command(0xF1); }
-    sh1106_command(SH1106_SETVCOMDETECT);                 // 0xDB
-    sh1106_command(0x40);
-    sh1106_command(SH1106_DISPLAYALLON_RESUME);           // 0xA4
-    sh1106_command(SH1106_NORMALDISPLAY);                 // 0xA6
-  #endif
-
-  #if defined SH1106_96_16
-    // Init sequence for 96x16 OLED module
-    sh1106_command(SH1106_DISPLAYOFF);                    // 0xAE
-    sh1106_command(SH1106_SETDISPLAYCLOCKDIV);            // 0xD5
-    sh1106_command(0x80);                                  // the suggested ratio 0x80
-    sh1106_command(SH1106_SETMULTIPLEX);                  // 0xA8
-    sh1106_command(0x0F);
-    sh1106_command(SH1106_SETDISPLAYOFFSET);              // 0xD3
-    sh1106_command(0x00);                                   // no offset
-    sh1106_command(SH1106_SETSTARTLINE | 0x0);            // line #0
-    sh1106_command(SH1106_CHARGEPUMP);                    // 0x8D
-    if (vccstate == SH1106_EXTERNALVCC) 
-      { sh1106_command(0x10); }
-    else 
-      { sh1106_command(0x14); }
-    sh1106_command(SH1106_MEMORYMODE);                    // 0x20
-    sh1106_command(0x00);                                  // 0x0 act like ks0108
-    sh1106_command(SH1106_SEGREMAP | 0x1);
-    sh1106_command(SH1106_COMSCANDEC);
-    sh1106_command(SH1106_SETCOMPINS);                    // 0xDA
-    sh1106_command(0x2);	//ada x12
-    sh1106_command(SH1106_SETCONTRAST);                   // 0x81
-    if (vccstate == SH1106_EXTERNALVCC) 
-      { sh1106_command(0x10); }
-    else 
-      { sh1106_command(0xAF); }
-    sh1106_command(SH1106_SETPRECHARGE);                  // 0xd9
-    if (vccstate == SH1106_EXTERNALVCC) 
-      { sh1106_command(0x22); }
-    else 
-      { sh1106_command(0xF1); }
-    sh1106_command(SH1106_SETVCOMDETECT);                 // 0xDB
-    sh1106_command(0x40);
-    sh1106_command(SH1106_DISPLAYALLON_RESUME);           // 0xA4
-    sh1106_command(SH1106_NORMALDISPLAY);                 // 0xA6
-  #endif
-
-  sh1106_command(SH1106_DISPLAYON);//--turn on oled panel
+#ifdef SH1106_CLOCK_TUNING
+  // probe the clock once the panel is out of reset (SPI returns at once)
+  tuneI2CClock(false);
+#endif
+  sendInit();
+}
+
+// init sequence, sent as one command list. Built here rather than in
+// PROGMEM because a few values depend on vccstate and the panel height, and
+// contrast, start line and inversion are the last ones set (begin() resets
+// them), so a re-init after a bus recovery keeps them
+void Adafruit_SH1106::sendInit(void) {
+  bool ext = (_vccstate == SH1106_EXTERNALVCC);
+  uint8_t comPins = (SH1106_PANEL_HEIGHT == 64) ? 0x12 : 0x02; //ada x12 for 96x16
+  const uint8_t init[] = {
+    SH1106_DISPLAYOFF,                    // 0xAE
+    SH1106_SETDISPLAYCLOCKDIV, 0x80,      // 0xD5, the suggested ratio 0x80
+    SH1106_SETMULTIPLEX, (uint8_t)(SH1106_PANEL_HEIGHT - 1), // 0xA8
+    SH1106_SETDISPLAYOFFSET, 0x00,        // 0xD3, no offset
+    (uint8_t)(SH1106_SETSTARTLINE | startLine),
+    SH1106_CHARGEPUMP,                    // 0x8D
+    (uint8_t)(ext ? 0x10 : 0x14),
+    SH1106_MEMORYMODE, 0x00,              // 0x20, 0x0 act like ks0108
+    SH1106_SEGREMAP | 0x1,
+    SH1106_COMSCANDEC,
+    SH1106_SETCOMPINS, comPins,           // 0xDA
+    SH1106_SETCONTRAST, contrastLevel,    // 0x81
+    SH1106_SETPRECHARGE,                  // 0xd9
+    (uint8_t)(ext ? 0x22 : 0xF1),
+    SH1106_SETVCOMDETECT, 0x40,           // 0xDB
+    SH1106_DISPLAYALLON_RESUME,           // 0xA4
+    (uint8_t)(inverted ? SH1106_INVERTDISPLAY : SH1106_NORMALDISPLAY),
+    SH1106_DISPLAYON                      //--turn on oled panel
+  };
+  commandBytes(init, sizeof(init), false);
+}
+
+// the contrast begin() sets, which depends on vccstate and the panel height
+uint8_t Adafruit_SH1106::getInitContrast(void) {
+  bool ext = (_vccstate == SH1106_EXTERNALVCC);
+  if (SH1106_PANEL_HEIGHT == 64) return ext ? 0x9F : 0xCF;
+  if (SH1106_PANEL_HEIGHT == 32) return 0x8F;
+  return ext ? 0x10 : 0xAF;
+}
+
+void Adafruit_SH1106::beginWire(void) {
+  if(sda == -1 || scl == -1){
+  Wire.begin();
+#ifdef __SAM3X8E__
+  // Force 400 KHz I2C, rawr! (Uses pins 20, 21 for SDA, SCL)
+  TWI1->TWI_CWGR = 0;
+  TWI1->TWI_CWGR = ((VARIANT_MCK / (2 * 400000)) - 4) * 0x101;
+#endif
+  } else {
+     Wire.begin(sda, scl); 
+  }
+#ifdef SH1106_CLOCK_TUNING
+  if (i2cClock) Wire.setClock(i2cClock);
+#endif
+  // give up on a transaction the bus hangs in after a bounded time, rather
+  // than the Wire library's default (50 ms or more, or forever)
+#if defined(ESP32)
+  Wire.setTimeOut(SH1106_I2C_TIMEOUT_MS);
+#elif defined(WIRE_HAS_TIMEOUT)
+  Wire.setWireTimeout(SH1106_I2C_TIMEOUT_MS * 1000UL, true);
+#endif
+}
+
+// send n bytes through BusIO, as many I2C transactions as it takes (at most
+// chunk bytes each, 0 to fill the Wire buffer), each led by the control
+// byte. A NACK or timeout is counted and marks the bus as failed: the rest
+// of the frame or command list is dropped, further commands are skipped,
+// and display() runs recoverBus(). The Wire status of the failed
+// transaction is kept for getLastI2CError()
+bool Adafruit_SH1106::i2cSend(uint8_t control, const uint8_t *d, uint16_t n, uint16_t chunk) {
+  if (busFailed || !i2c_dev) return false;
+  if (i2c_dev->write_stream(d, n, &control, 1, chunk)) return true;
+  lastI2CError = i2c_dev->lastWriteStatus();
+  i2cErrors++;
+  busFailed = true;
+  return false;
+}
+
+// send display data (Co = 0, D/C = 1). At the Wire default of 100 kHz a
+// transaction filling the Wire buffer can take longer than
+// SH1106_I2C_TIMEOUT_MS, so they are kept to 16 bytes unless a faster clock
+// was set
+bool Adafruit_SH1106::i2cData(const uint8_t *d, uint16_t n) {
+  return i2cSend(0x40, d, n, (i2cClock >= 400000) ? 0 : 16);
+}
+
+// unwedge the bus and bring the panel back: clock SCL up to 9 times until a
+// slave stuck mid-byte lets go of SDA, send a STOP, restart Wire and re-send
+// the init sequence (which keeps contrast, start line and inversion, and
+// stops scrolling). Runs at most once every
+// SH1106_RECOVERY_INTERVAL_MS, so a panel that stays unreachable costs at
+// most one failed transaction per attempt. Returns whether the re-init went
+// through.
+bool Adafruit_SH1106::recoverBus(void) {
+  if ((long)(millis() - recoverAt) < 0) return false;
+  recoverAt = millis() + SH1106_RECOVERY_INTERVAL_MS;
+  busRecoveries++;
+
+  clearBus();
+  shownValid = 0;
+  sendInit();
+  return !busFailed;
+}
+
+// the bus clear part of recoverBus(), ending with Wire restarted
+void Adafruit_SH1106::clearBus(void) {
+  uint8_t sdaPin = (sda == -1) ? SDA : sda, sclPin = (scl == -1) ? SCL : scl;
+#ifndef ESP8266
+  Wire.end();
+#endif
+  pinMode(sdaPin, INPUT_PULLUP);
+  pinMode(sclPin, INPUT_PULLUP);
+  for (uint8_t i = 0; (i < 9) && !digitalRead(sdaPin); i++) {
+    pinMode(sclPin, OUTPUT);
+    digitalWrite(sclPin, LOW);
+    delayMicroseconds(5);
+    pinMode(sclPin, INPUT_PULLUP);
+    delayMicroseconds(5);
+  }
+  // STOP: SDA rises while SCL is high
+  pinMode(sdaPin, OUTPUT);
+  digitalWrite(sdaPin, LOW);
+  delayMicroseconds(5);
+  pinMode(sdaPin, INPUT_PULLUP);
+  delayMicroseconds(5);
+
+  beginWire();
+  busFailed = false;
+}
+
+#ifdef SH1106_CLOCK_TUNING
+// bus clocks tried by tuneI2CClock(), slowest first
+static const uint32_t sh1106_clocks[] = { 100000, 400000, 800000, 1000000 };
+
+// write two patterns to the last page of display RAM at the current clock
+// and read each back. A read starts with the page and column address and
+// a dummy byte, as the controller's read latch lags the address by one.
+// The reads use normal mode rather than read-modify-write (0xE0), where the
+// column does not advance on reads; either way the page is overwritten and
+// has to be repainted.
+bool Adafruit_SH1106::clockWorks(void) {
+  const uint8_t page = SH1106_PANEL_HEIGHT/8 - 1;
+  const uint8_t chunk = SH1106_WIRE_MAX - 1;
+  for (uint8_t pass = 0; pass < 2; pass++) {
+    uint8_t cmd[3] = SH1106_PAGE_CMD(page);
+    commandBytes(cmd, sizeof(cmd), false);
+    uint8_t pattern[132];
+    for (uint8_t k = 0; k < SH1106_PANEL_WIDTH; k++)
+      pattern[k] = (k * 37 + 0x5A) ^ (pass ? 0xFF : 0x00);
+    i2cData(pattern, SH1106_PANEL_WIDTH);
+    for (uint8_t x = 0; (x < SH1106_PANEL_WIDTH) && !busFailed; x += chunk) {
+      uint8_t col = colOffset + x, n = min((int)chunk, SH1106_PANEL_WIDTH - x);
+      const uint8_t at[3] = { (uint8_t)(0xB0 + page), (uint8_t)(col & 0x0F), (uint8_t)(SH1106_SETHIGHCOLUMN | (col >> 4)) };
+      commandBytes(at, sizeof(at), false);
+      const uint8_t control = 0x40;        // Co = 0, D/C = 1, then read
+      uint8_t got[SH1106_WIRE_MAX];
+      if (busFailed || !i2c_dev->write(&control, 1) || !i2c_dev->read(got, n + 1)) return false;
+      for (uint8_t k = x; k < x + n; k++) {  // got[0] is a dummy
+        if (got[k - x + 1] != (uint8_t)((k * 37 + 0x5A) ^ (pass ? 0xFF : 0x00))) return false;
+      }
+    }
+    if (busFailed) return false;
+  }
+  return true;
 }
 
+// pick the fastest clock up to SH1106_I2C_MAX_CLOCK at which the panel
+// reads back what was written, and keep it in NVS (per I2C address) so
+// later boots only re-check that one. A clock that fails leaves the
+// previous one; if even 100 kHz cannot be verified (a module without a
+// working read path, say) the panel's rated 400 kHz is used and nothing is
+// stored. Errors while probing are not counted in getI2CErrors(). force
+// ignores the stored clock.
+void Adafruit_SH1106::tuneI2CClock(bool force) {
+  if (dc != -1) return;
+  uint32_t errors = i2cErrors;
+  uint8_t lastError = lastI2CError;
+  char key[8];
+  snprintf(key, sizeof(key), "clk%02x", (uint8_t)_i2caddr);
+
+  Preferences prefs;
+  prefs.begin("sh1106", false);
+  uint32_t stored = force ? 0 : prefs.getUInt(key, 0);
+  if (stored > SH1106_I2C_MAX_CLOCK) stored = 0; // kept by a build with a higher limit
+  uint32_t best = 0;
+  if (stored) {
+    Wire.setClock(stored);
+    if (clockWorks()) best = stored;
+    else clearBus();
+  }
+  if (!best) {
+    for (uint8_t i = 0; i < sizeof(sh1106_clocks)/sizeof(sh1106_clocks[0]); i++) {
+      if (sh1106_clocks[i] > SH1106_I2C_MAX_CLOCK) break;
+      Wire.setClock(sh1106_clocks[i]);
+      if (!clockWorks()) {
+        clearBus();
+        break;
+      }
+      best = sh1106_clocks[i];
+    }
+    if (best && (best != stored)) prefs.putUInt(key, best);
+  }
+  prefs.end();
+
+  i2cClock = best ? best : 400000;
+  Wire.setClock(i2cClock);
+  i2cErrors = errors;
+  lastI2CError = lastError;
+  busFailed = false;
+  shownValid = 0;
+}
+#endif
+
 
 void Adafruit_SH1106::invertDisplay(uint8_t i) {
+  inverted = i;
   if (i) {
     sh1106_command(SH1106_INVERTDISPLAY);
   } else {
@@ -353,28 +571,59 @@ void Adafruit_SH1106::invertDisplay(uint8_t i) {
   }
 }
 
-void Adafruit_SH1106::sh1106_command(uint8_t c) { 
-  if (sid != -1)
+void Adafruit_SH1106::sh1106_command(uint8_t c) {
+  commandBytes(&c, 1, false);
+}
+
+// send a list of command bytes from PROGMEM, as one I2C transaction (or as
+// few as the Wire buffer allows) or one SPI burst
+void Adafruit_SH1106::sh1106_commandList(const uint8_t *c, uint8_t n) {
+  commandBytes(c, n, true);
+}
+
+// send n command bytes from c, read from PROGMEM if progmem is set. Over
+// I2C this is one control byte (Co = 0, D/C = 0) and the list, split only
+// where it would overflow the Wire buffer; over SPI one DC-low burst with
+// CS held
+void Adafruit_SH1106::commandBytes(const uint8_t *c, uint8_t n, bool progmem) {
+  if (hwSPI)
+  {
+    SPI.beginTransaction(spiSettings);
+    *dcport &= ~dcpinmask;
+    *csport &= ~cspinmask;
+    if (progmem) {
+      while (n--) SPI.transfer(pgm_read_byte(c++));
+    } else {
+      spiWrite(c, n);
+    }
+    *csport |= cspinmask;
+    SPI.endTransaction();
+  }
+  else if (dc != -1)
   {
     // SPI
-    //digitalWrite(cs, HIGH);
     *csport |= cspinmask;
-    //digitalWrite(dc, LOW);
     *dcport &= ~dcpinmask;
-    //digitalWrite(cs, LOW);
     *csport &= ~cspinmask;
-    fastSPIwrite(c);
-    //digitalWrite(cs, HIGH);
+    while (n--) fastSPIwrite(progmem ? pgm_read_byte(c++) : *c++);
     *csport |= cspinmask;
   }
   else
   {
-    // I2C
-    uint8_t control = 0x00;   // Co = 0, D/C = 0
-    Wire.beginTransmission(_i2caddr);
-    WIRE_WRITE(control);
-    WIRE_WRITE(c);
-    Wire.endTransmission();
+    // I2C, Co = 0, D/C = 0. A PROGMEM list is copied out a transaction's
+    // worth at a time
+    if (!progmem) {
+      i2cSend(0x00, c, n, 0);
+      return;
+    }
+    uint8_t buf[SH1106_WIRE_MAX - 1];
+    while (n && !busFailed) {
+      uint8_t k = min((int)n, (int)sizeof(buf));
+      memcpy_P(buf, c, k);
+      i2cSend(0x00, buf, k, 0);
+      c += k;
+      n -= k;
+    }
   }
 }
 
@@ -383,14 +632,8 @@ void Adafruit_SH1106::sh1106_command(uint8_t c) {
 // Hint, the display is 16 rows tall. To scroll the whole display, run:
 // display.scrollright(0x00, 0x0F) 
 void Adafruit_SH1106::startscrollright(uint8_t start, uint8_t stop){
-  sh1106_command(SH1106_RIGHT_HORIZONTAL_SCROLL);
-  sh1106_command(0X00);
-  sh1106_command(start);
-  sh1106_command(0X00);
-  sh1106_command(stop);
-  sh1106_command(0X00);
-  sh1106_command(0XFF);
-  sh1106_command(SH1106_ACTIVATE_SCROLL);
+  const uint8_t c[] = { SH1106_RIGHT_HORIZONTAL_SCROLL, 0X00, start, 0X00, stop, 0X00, 0XFF, SH1106_ACTIVATE_SCROLL };
+  commandBytes(c, sizeof(c), false);
 }
 
 // startscrollleft
@@ -398,14 +641,8 @@ void Adafruit_SH1106::startscrollright(uint8_t start, uint8_t stop){
 // Hint, the display is 16 rows tall. To scroll the whole display, run:
 // display.scrollright(0x00, 0x0F) 
 void Adafruit_SH1106::startscrollleft(uint8_t start, uint8_t stop){
-  sh1106_command(SH1106_LEFT_HORIZONTAL_SCROLL);
-  sh1106_command(0X00);
-  sh1106_command(start);
-  sh1106_command(0X00);
-  sh1106_command(stop);
-  sh1106_command(0X00);
-  sh1106_command(0XFF);
-  sh1106_command(SH1106_ACTIVATE_SCROLL);
+  const uint8_t c[] = { SH1106_LEFT_HORIZONTAL_SCROLL, 0X00, start, 0X00, stop, 0X00, 0XFF, SH1106_ACTIVATE_SCROLL };
+  commandBytes(c, sizeof(c), false);
 }
 
 // startscrolldiagright
@@ -413,16 +650,9 @@ void Adafruit_SH1106::startscrollleft(uint8_t start, uint8_t stop){
 // Hint, the display is 16 rows tall. To scroll the whole display, run:
 // display.scrollright(0x00, 0x0F) 
 void Adafruit_SH1106::startscrolldiagright(uint8_t start, uint8_t stop){
-  sh1106_command(SH1106_SET_VERTICAL_SCROLL_AREA);  
-  sh1106_command(0X00);
-  sh1106_command(SH1106_LCDHEIGHT);
-  sh1106_command(SH1106_VERTICAL_AND_RIGHT_HORIZONTAL_SCROLL);
-  sh1106_command(0X00);
-  sh1106_command(start);
-  sh1106_command(0X00);
-  sh1106_command(stop);
-  sh1106_command(0X01);
-  sh1106_command(SH1106_ACTIVATE_SCROLL);
+  const uint8_t c[] = { SH1106_SET_VERTICAL_SCROLL_AREA, 0X00, (uint8_t)SH1106_PANEL_HEIGHT,
+                        SH1106_VERTICAL_AND_RIGHT_HORIZONTAL_SCROLL, 0X00, start, 0X00, stop, 0X01, SH1106_ACTIVATE_SCROLL };
+  commandBytes(c, sizeof(c), false);
 }
 
 // startscrolldiagleft
@@ -430,16 +660,9 @@ void Adafruit_SH1106::startscrolldiagright(uint8_t start, uint8_t stop){
 // Hint, the display is 16 rows tall. To scroll the whole display, run:
 // display.scrollright(0x00, 0x0F) 
 void Adafruit_SH1106::startscrolldiagleft(uint8_t start, uint8_t stop){
-  sh1106_command(SH1106_SET_VERTICAL_SCROLL_AREA);  
-  sh1106_command(0X00);
-  sh1106_command(SH1106_LCDHEIGHT);
-  sh1106_command(SH1106_VERTICAL_AND_LEFT_HORIZONTAL_SCROLL);
-  sh1106_command(0X00);
-  sh1106_command(start);
-  sh1106_command(0X00);
-  sh1106_command(stop);
-  sh1106_command(0X01);
-  sh1106_command(SH1106_ACTIVATE_SCROLL);
+  const uint8_t c[] = { SH1106_SET_VERTICAL_SCROLL_AREA, 0X00, (uint8_t)SH1106_PANEL_HEIGHT,
+                        SH1106_VERTICAL_AND_LEFT_HORIZONTAL_SCROLL, 0X00, start, 0X00, stop, 0X01, SH1106_ACTIVATE_SCROLL };
+  commandBytes(c, sizeof(c), false);
 }
 
 void Adafruit_SH1106::stopscroll(void){
@@ -463,12 +686,37 @@ void Adafruit_SH1106::dim(boolean dim) {
   }
   // the range of contrast to too small to be really useful
   // it is useful to dim the display
-  sh1106_command(SH1106_SETCONTRAST);
-  sh1106_command(contrast);
+  setContrast(contrast);
+}
+
+// set the contrast (segment current) register, 0-255. Steps of this are
+// what a fade costs: two command bytes, no pixels
+void Adafruit_SH1106::setContrast(uint8_t contrast) {
+  contrastLevel = contrast;
+  const uint8_t c[] = { SH1106_SETCONTRAST, contrast };
+  commandBytes(c, sizeof(c), false);
+}
+
+// set the display start line, 0-63: controller RAM row `line` is shown on
+// the top row, so the picture moves up by `line` rows and wraps around the
+// 64 rows of RAM. One command byte, the framebuffer is left alone, which
+// makes it a cheap vertical shake or scroll
+void Adafruit_SH1106::setStartLine(uint8_t line) {
+  startLine = line & 0x3F;
+  sh1106_command(SH1106_SETSTARTLINE | startLine);
 }
 
 void Adafruit_SH1106::sh1106_data(uint8_t c) {
-  if (sid != -1)
+  if (hwSPI)
+  {
+    SPI.beginTransaction(spiSettings);
+    *dcport |= dcpinmask;
+    *csport &= ~cspinmask;
+    SPI.transfer(c);
+    *csport |= cspinmask;
+    SPI.endTransaction();
+  }
+  else if (dc != -1)
   {
     // SPI
     //digitalWrite(cs, HIGH);
@@ -484,32 +732,134 @@ void Adafruit_SH1106::sh1106_data(uint8_t c) {
   else
   {
     // I2C
-    uint8_t control = 0x40;   // Co = 0, D/C = 1
-    Wire.beginTransmission(_i2caddr);
-    WIRE_WRITE(control);
-    WIRE_WRITE(c);
-    Wire.endTransmission();
+    i2cData(&c, 1);
+  }
+}
+
+// bit mask of the pages drawing has touched since the last display(), from
+// the dirty rectangles Adafruit_GFX keeps in framebuffer coordinates
+uint8_t Adafruit_SH1106::dirtyPages(void) {
+  uint8_t n, pages = 0;
+  const GFXrect *r = getDirtyRects(&n);
+  for (uint8_t i = 0; i < n; i++) {
+    for (int16_t p = r[i].y / 8; p <= (r[i].y + r[i].h - 1) / 8; p++)
+      pages |= 1 << p;
+  }
+  return pages;
+}
+
+// bit mask of the pages display() has to send, which are then taken as sent.
+// Only dirty pages can have changed. With a shadow copy (shown, the
+// framebuffer as last sent), display() can also leave out dirty pages whose
+// bytes came out the same. shownValid has a bit per page that is known to
+// be on the panel; begin() clears it, as controller RAM is random after reset
+uint8_t Adafruit_SH1106::changedPages(void) {
+  uint8_t pages = 0, valid = shownValid;
+  uint8_t check = (dirtyPages() | ~valid) & (0xFF >> (8 - SH1106_PANEL_HEIGHT/8));
+  shownValid = 0xFF;
+  if (!shown) return check;
+  for (uint8_t i = 0; i < SH1106_PANEL_HEIGHT/8; i++) {
+    if (!(check & (1 << i))) continue;
+    uint8_t *p = &buffer[i*SH1106_PANEL_WIDTH], *q = &shown[i*SH1106_PANEL_WIDTH];
+    if (!(valid & (1 << i)) || memcmp(p, q, SH1106_PANEL_WIDTH)) {
+      memcpy(q, p, SH1106_PANEL_WIDTH);
+      pages |= 1 << i;
+    }
   }
+  return pages;
 }
 
+// the dirty rectangles are cleared once the frame is out. Over I2C a failed
+// transaction ends the frame there; the bus is then recovered and, as the
+// panel can no longer be trusted, repainted in full by the next display().
+// The worst case for one call is two transaction timeouts (the frame and
+// the re-init) plus the bus clear.
 void Adafruit_SH1106::display(void) {
-  if (sid != -1)
+  if (!buffer) return;
+  if (busFailed && !recoverBus()) return;
+  uint8_t pages = changedPages();
+  clearDirty();
+  if (pages) sendPages(buffer, pages, false, SH1106_PANEL_WIDTH);
+  if (busFailed) {
+    shownValid = 0;
+    recoverBus();
+  }
+}
+
+#ifndef SH1106_NO_SPLASH
+// put the splash screen on the panel straight from flash, e.g. while the
+// first real frame is being prepared. The framebuffer is left alone, and
+// the next display() sends all of it
+void Adafruit_SH1106::showSplash(void) {
+  if ((SH1106_PANEL_WIDTH != SH1106_LCDWIDTH) || (SH1106_PANEL_HEIGHT != SH1106_LCDHEIGHT)) return;
+  sendPages(splash, 0xFF, true, SH1106_PANEL_WIDTH);
+  shownValid = 0;
+}
+#endif
+
+// send one page of pixels (SH1106_PANEL_WIDTH bytes, a framebuffer page) straight to the
+// panel, for drawing without a framebuffer. A failed I2C transaction is
+// handled as in display(); false if the page didn't get out
+bool Adafruit_SH1106::sendPage(uint8_t page, const uint8_t *data) {
+  if (busFailed && !recoverBus()) return false;
+  sendPages(data, 1 << page, false, 0);
+  shownValid &= ~(1 << page);
+  if (busFailed) {
+    shownValid = 0;
+    recoverBus();
+    return false;
+  }
+  return true;
+}
+
+// send the pages set in the bit mask, page i from src + i*stride (so
+// framebuffer layout with a stride of SH1106_PANEL_WIDTH), read from PROGMEM if progmem
+// is set
+void Adafruit_SH1106::sendPages(const uint8_t *src, uint8_t pages, bool progmem, uint16_t stride) {
+
+  if (hwSPI)
+  {
+    // one transaction and one CS assertion for the whole frame. Per page the
+    // three addressing commands go out as one DC-low burst and the page
+    // data as one DC-high burst
+    SPI.beginTransaction(spiSettings);
+    *csport &= ~cspinmask;
+    for (int8_t i = (SH1106_PANEL_HEIGHT/8)-1; i >= 0; i--)
+    {
+      if (!(pages & (1 << i))) continue;
+      uint8_t cmd[3] = SH1106_PAGE_CMD(i);
+      *dcport &= ~dcpinmask;
+      spiWrite(cmd, sizeof(cmd));
+      *dcport |= dcpinmask;
+      const uint8_t *p = &src[i*stride];
+      if (progmem) {
+        for (uint16_t j = 0; j < SH1106_PANEL_WIDTH; j++) SPI.transfer(pgm_read_byte(p++));
+      } else {
+        spiWrite(p, SH1106_PANEL_WIDTH);
+      }
+    }
+    *csport |= cspinmask;
+    SPI.endTransaction();
+  }
+  else if (dc != -1)
   {
 
-  	for (int8_t i = (SH1106_LCDHEIGHT/8)-1; i >= 0; i--)
+  	for (int8_t i = (SH1106_PANEL_HEIGHT/8)-1; i >= 0; i--)
   	{
-      sh1106_command(0xB0 + i);		// Set row
-      sh1106_command(SH1106_SETLOWCOLUMN);		// Set lower column address
-      sh1106_command(SH1106_SETHIGHCOLUMN); // Set higher column address
+      if (!(pages & (1 << i))) continue;
+      // set row, lower and higher column address
+      const uint8_t cmd[3] = SH1106_PAGE_CMD(i);
+      commandBytes(cmd, sizeof(cmd), false);
       
       // SPI
       *csport |= cspinmask;
       *dcport |= dcpinmask;
       *csport &= ~cspinmask;
     
-      for (uint16_t j = SH1106_LCDWIDTH; j > 0; j--)
+      for (uint16_t j = SH1106_PANEL_WIDTH; j > 0; j--)
       {
-  		  fastSPIwrite(buffer[i*SH1106_LCDWIDTH+SH1106_LCDWIDTH-j]);
+        const uint8_t *p = &src[i*stride+SH1106_PANEL_WIDTH-j];
+  		  fastSPIwrite(progmem ? pgm_read_byte(p) : *p);
       }
       
       *csport |= cspinmask;
@@ -528,24 +878,20 @@ void Adafruit_SH1106::display(void) {
     //Serial.println(TWSR & 0x3, DEC);
 
     // I2C
-  	for (int8_t i = (SH1106_LCDHEIGHT/8)-1; i >= 0; i--)
+  	for (int8_t i = (SH1106_PANEL_HEIGHT/8)-1; (i >= 0) && !busFailed; i--)
   	{
-      sh1106_command(0xB0 + i);		// Set row
-      sh1106_command(SH1106_SETLOWCOLUMN);		// Set lower column address
-      sh1106_command(SH1106_SETHIGHCOLUMN); // Set higher column address
+      if (!(pages & (1 << i))) continue;
+      // set row, lower and higher column address
+      const uint8_t cmd[3] = SH1106_PAGE_CMD(i);
+      commandBytes(cmd, sizeof(cmd), false);
       
-      for (uint16_t j = SH1106_LCDWIDTH; j > 0; j--)
-      {
-        // send a bunch of data in one xmission
-        Wire.beginTransmission(_i2caddr);
-        WIRE_WRITE(0x40);
-        for (uint8_t x=0; x<16; x++) {
-          WIRE_WRITE(buffer[i*SH1106_LCDWIDTH+SH1106_LCDWIDTH-j]);
-          j--;
-        }
-        j++;
-        Wire.endTransmission();
+      const uint8_t *p = &src[i*stride];
+      uint8_t copy[132];          // a page is at most 132 RAM columns
+      if (progmem) {
+        memcpy_P(copy, p, SH1106_PANEL_WIDTH);
+        p = copy;
       }
+      i2cData(p, SH1106_PANEL_WIDTH);
     }
 #ifndef ESP32
 #ifndef __SAM3X8E__
@@ -557,28 +903,139 @@ void Adafruit_SH1106::display(void) {
 
 // clear everything
 void Adafruit_SH1106::clearDisplay(void) {
-  memset(buffer, 0, (SH1106_LCDWIDTH*SH1106_LCDHEIGHT/8));
+  if (buffer) memset(buffer, 0, (SH1106_PANEL_WIDTH*SH1106_PANEL_HEIGHT/8));
+  markDirty(0, 0, _width, _height);
 }
 
 
+// send n bytes with hardware SPI without touching the source (the
+// framebuffer). On the ESPs writeBytes() fills the SPI FIFO in 64-byte
+// chunks and returns once the last bit is out, so DC can be switched right
+// after; elsewhere SPI.transfer(buf, n) would overwrite buf, so bytes go one
+// at a time.
+void Adafruit_SH1106::spiWrite(const uint8_t *d, uint16_t n) {
+#if defined(ESP32) || defined(ESP8266)
+  SPI.writeBytes(d, n);
+#else
+  while (n--) SPI.transfer(*d++);
+#endif
+}
+
+// software SPI; hardware SPI goes through spiWrite() and SPI.transfer()
 inline void Adafruit_SH1106::fastSPIwrite(uint8_t d) {
-  
-  if(hwSPI) {
-    (void)SPI.transfer(d);
-  } else {
-    for(uint8_t bit = 0x80; bit; bit >>= 1) {
-      *clkport &= ~clkpinmask;
-      if(d & bit) *mosiport |=  mosipinmask;
-      else        *mosiport &= ~mosipinmask;
-      *clkport |=  clkpinmask;
+  for(uint8_t bit = 0x80; bit; bit >>= 1) {
+    *clkport &= ~clkpinmask;
+    if(d & bit) *mosiport |=  mosipinmask;
+    else        *mosiport &= ~mosipinmask;
+    *clkport |=  clkpinmask;
+  }
+}
+
+// span writers. A span is the same rows (bit mask m) of n adjacent columns,
+// i.e. n consecutive bytes of one page. Between a byte-wise head and tail
+// the mask is applied a machine word (4 or 8 columns) at a time, with m
+// copied into every byte lane; a whole-byte WHITE or BLACK span is a
+// memset. Each color gets its own copy of the loops.
+typedef uintptr_t span_word_t;
+
+template <uint16_t COLOR, typename T> static inline T maskOp(T v, T m) {
+  return (COLOR == WHITE) ? (v | m) : (COLOR == BLACK) ? (v & ~m) : (v ^ m);
+}
+
+template <uint16_t COLOR> static void spanOp(uint8_t *d, int16_t n, uint8_t m) {
+  if ((m == 0xFF) && (COLOR != INVERSE)) {
+    memset(d, (COLOR == WHITE) ? 0xFF : 0x00, n);
+    return;
+  }
+  if (n >= (int16_t)(2 * sizeof(span_word_t))) {  // short spans stay byte-wise
+    for (; (uintptr_t)d & (sizeof(span_word_t) - 1); n--, d++)
+      *d = maskOp<COLOR, uint8_t>(*d, m);
+    span_word_t mw = (span_word_t)-1 / 0xFF * m;
+    for (; n >= (int16_t)sizeof(span_word_t); n -= sizeof(span_word_t), d += sizeof(span_word_t)) {
+      span_word_t v;
+      memcpy(&v, d, sizeof(v));
+      v = maskOp<COLOR, span_word_t>(v, mw);
+      memcpy(d, &v, sizeof(v));
     }
   }
-  //*csport |= cspinmask;
+  for (; n; n--, d++)
+    *d = maskOp<COLOR, uint8_t>(*d, m);
+}
+
+static void fillSpan(uint8_t *d, int16_t n, uint8_t m, uint16_t color) {
+  switch (color)
+  {
+    case WHITE:   spanOp<WHITE>(d, n, m);   break;
+    case BLACK:   spanOp<BLACK>(d, n, m);   break;
+    case INVERSE: spanOp<INVERSE>(d, n, m); break;
+  }
+}
+
+// bits of display page p that fall within rows y1..y2-1
+static uint8_t pageMask(int16_t p, int16_t y1, int16_t y2) {
+  int16_t top = p * 8;
+  if ((y1 >= top + 8) || (y2 <= top)) return 0;
+  uint8_t m = 0xFF;
+  if (y1 > top) m &= 0xFF << (y1 - top);
+  if (y2 < top + 8) m &= 0xFF >> (top + 8 - y2);
+  return m;
+}
+
+// fill a rectangle given in buffer coordinates, already clipped: a masked
+// span for a partial top and bottom page, whole-byte spans in between.
+// Full-width rectangles are contiguous in the buffer (of width bytes per
+// page), so their whole pages go out as a single span.
+static void fillPages(uint8_t *buf, int16_t width, int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+  int16_t p = y / 8, pe = (y + h - 1) / 8;
+  uint8_t *pBuf = &buf[p * width + x];
+
+  if ((y & 7) || (p == pe)) {
+    fillSpan(pBuf, w, pageMask(p, y, y + h), color);
+    pBuf += width;
+    p++;
+  }
+  if (p > pe) return;
+
+  int16_t full = ((y + h) & 7) ? pe - p : pe - p + 1;
+  if (full) {
+    if (w == width) {
+      fillSpan(pBuf, full * width, 0xFF, color);
+      pBuf += full * width;
+    } else {
+      for (int16_t i = 0; i < full; i++, pBuf += width)
+        fillSpan(pBuf, w, 0xFF, color);
+    }
+  }
+  if ((y + h) & 7)
+    fillSpan(pBuf, w, pageMask(pe, y, y + h), color);
+}
+
+// a whole rectangle at once, page by page, instead of one vertical line
+// per column
+void Adafruit_SH1106::fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+  if (!buffer) return;
+  markDirty(x, y, w, h);
+  // like the per-column version, negative sizes draw nothing here
+  if ((w <= 0) || (h <= 0) || !clipRawRect(&x, &y, &w, &h)) return;
+  fillPages(buffer, SH1106_PANEL_WIDTH, x, y, w, h, color);
 }
 
 void Adafruit_SH1106::drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) {
+  markDirty(x, y, w, 1);
+  // clip to the clip rect while still in logical coordinates, the display
+  // edges are checked by the Internal functions
+  if ((y < clip_y1) || (y >= clip_y2)) { return; }
+  if (x < clip_x1) {
+    w -= clip_x1 - x;
+    x = clip_x1;
+  }
+  if ((x + w) > clip_x2) {
+    w = clip_x2 - x;
+  }
+  if (w <= 0) { return; }
+
   boolean bSwap = false;
-  switch(rotation) { 
+  switch(SH1106_ROTATION) { 
     case 0:
       // 0 degree rotation, do nothing
       break;
@@ -586,19 +1043,19 @@ void Adafruit_SH1106::drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t co
       // 90 degree rotation, swap x & y for rotation, then invert x
       bSwap = true;
       swap(x, y);
-      x = WIDTH - x - 1;
+      x = SH1106_PANEL_WIDTH - x - 1;
       break;
     case 2:
       // 180 degree rotation, invert x and y - then shift y around for height.
-      x = WIDTH - x - 1;
-      y = HEIGHT - y - 1;
+      x = SH1106_PANEL_WIDTH - x - 1;
+      y = SH1106_PANEL_HEIGHT - y - 1;
       x -= (w-1);
       break;
     case 3:
       // 270 degree rotation, swap x & y for rotation, then invert y  and adjust y for w (not to become h)
       bSwap = true;
       swap(x, y);
-      y = HEIGHT - y - 1;
+      y = SH1106_PANEL_HEIGHT - y - 1;
       y -= (w-1);
       break;
   }
@@ -611,8 +1068,9 @@ void Adafruit_SH1106::drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t co
 }
 
 void Adafruit_SH1106::drawFastHLineInternal(int16_t x, int16_t y, int16_t w, uint16_t color) {
+  if (!buffer) return;
   // Do bounds/limit checks
-  if(y < 0 || y >= HEIGHT) { return; }
+  if(y < 0 || y >= SH1106_PANEL_HEIGHT) { return; }
 
   // make sure we don't try to draw below 0
   if(x < 0) { 
@@ -621,53 +1079,52 @@ void Adafruit_SH1106::drawFastHLineInternal(int16_t x, int16_t y, int16_t w, uin
   }
 
   // make sure we don't go off the edge of the display
-  if( (x + w) > WIDTH) { 
-    w = (WIDTH - x);
+  if( (x + w) > SH1106_PANEL_WIDTH) { 
+    w = (SH1106_PANEL_WIDTH - x);
   }
 
   // if our width is now negative, punt
   if(w <= 0) { return; }
 
-  // set up the pointer for  movement through the buffer
-  register uint8_t *pBuf = buffer;
-  // adjust the buffer pointer for the current row
-  pBuf += ((y/8) * SH1106_LCDWIDTH);
-  // and offset x columns in
-  pBuf += x;
-
-  register uint8_t mask = 1 << (y&7);
-
-  switch (color) 
-  {
-  case WHITE:         while(w--) { *pBuf++ |= mask; }; break;
-    case BLACK: mask = ~mask;   while(w--) { *pBuf++ &= mask; }; break;
-  case INVERSE:         while(w--) { *pBuf++ ^= mask; }; break;
-  }
+  // one bit of w consecutive bytes in the row's page
+  fillSpan(&buffer[(y/8) * SH1106_PANEL_WIDTH + x], w, 1 << (y&7), color);
 }
 
 void Adafruit_SH1106::drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) {
+  markDirty(x, y, 1, h);
+  // clip to the clip rect, as in drawFastHLine()
+  if ((x < clip_x1) || (x >= clip_x2)) { return; }
+  if (y < clip_y1) {
+    h -= clip_y1 - y;
+    y = clip_y1;
+  }
+  if ((y + h) > clip_y2) {
+    h = clip_y2 - y;
+  }
+  if (h <= 0) { return; }
+
   bool bSwap = false;
-  switch(rotation) { 
+  switch(SH1106_ROTATION) { 
     case 0:
       break;
     case 1:
       // 90 degree rotation, swap x & y for rotation, then invert x and adjust x for h (now to become w)
       bSwap = true;
       swap(x, y);
-      x = WIDTH - x - 1;
+      x = SH1106_PANEL_WIDTH - x - 1;
       x -= (h-1);
       break;
     case 2:
       // 180 degree rotation, invert x and y - then shift y around for height.
-      x = WIDTH - x - 1;
-      y = HEIGHT - y - 1;
+      x = SH1106_PANEL_WIDTH - x - 1;
+      y = SH1106_PANEL_HEIGHT - y - 1;
       y -= (h-1);
       break;
     case 3:
       // 270 degree rotation, swap x & y for rotation, then invert y 
       bSwap = true;
       swap(x, y);
-      y = HEIGHT - y - 1;
+      y = SH1106_PANEL_HEIGHT - y - 1;
       break;
   }
 
@@ -680,9 +1137,10 @@ void Adafruit_SH1106::drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t co
 
 
 void Adafruit_SH1106::drawFastVLineInternal(int16_t x, int16_t __y, int16_t __h, uint16_t color) {
+  if (!buffer) return;
 
   // do nothing if we're off the left or right side of the screen
-  if(x < 0 || x >= WIDTH) { return; }
+  if(x < 0 || x >= SH1106_PANEL_WIDTH) { return; }
 
   // make sure we don't try to draw below 0
   if(__y < 0) { 
@@ -693,8 +1151,8 @@ void Adafruit_SH1106::drawFastVLineInternal(int16_t x, int16_t __y, int16_t __h,
   } 
 
   // make sure we don't go past the height of the display
-  if( (__y + __h) > HEIGHT) { 
-    __h = (HEIGHT - __y);
+  if( (__y + __h) > SH1106_PANEL_HEIGHT) { 
+    __h = (SH1106_PANEL_HEIGHT - __y);
   }
 
   // if our height is now negative, punt 
@@ -710,7 +1168,7 @@ void Adafruit_SH1106::drawFastVLineInternal(int16_t x, int16_t __y, int16_t __h,
   // set up the pointer for fast movement through the buffer
   register uint8_t *pBuf = buffer;
   // adjust the buffer pointer for the current row
-  pBuf += ((y/8) * SH1106_LCDWIDTH);
+  pBuf += ((y/8) * SH1106_PANEL_WIDTH);
   // and offset x columns in
   pBuf += x;
 
@@ -742,7 +1200,7 @@ void Adafruit_SH1106::drawFastVLineInternal(int16_t x, int16_t __y, int16_t __h,
 
     h -= mod;
 
-    pBuf += SH1106_LCDWIDTH;
+    pBuf += SH1106_PANEL_WIDTH;
   }
 
 
@@ -753,7 +1211,7 @@ void Adafruit_SH1106::drawFastVLineInternal(int16_t x, int16_t __y, int16_t __h,
       *pBuf=~(*pBuf);
 
         // adjust the buffer forward 8 rows worth of data
-        pBuf += SH1106_LCDWIDTH;
+        pBuf += SH1106_PANEL_WIDTH;
 
         // adjust h & y (there's got to be a faster way for me to do this, but this should still help a fair bit for now)
         h -= 8;
@@ -768,7 +1226,7 @@ void Adafruit_SH1106::drawFastVLineInternal(int16_t x, int16_t __y, int16_t __h,
       *pBuf = val;
 
         // adjust the buffer forward 8 rows worth of data
-        pBuf += SH1106_LCDWIDTH;
+        pBuf += SH1106_PANEL_WIDTH;
 
         // adjust h & y (there's got to be a faster way for me to do this, but this should still help a fair bit for now)
         h -= 8;
@@ -792,3 +1250,287 @@ void Adafruit_SH1106::drawFastVLineInternal(int16_t x, int16_t __y, int16_t __h,
     }
   }
 }
+
+// merge one page-row of canvas bytes into the framebuffer. Each source byte
+// is moved up by ls bits (kept to 8 bits) then down by rs, so a canvas page
+// straddling two display pages is written as two spans: (ls=shift, rs=0)
+// for the upper page and (ls=0, rs=8-shift) for the lower one.
+static void blitSpan(uint8_t *d, const uint8_t *s, int16_t n, uint8_t ls, uint8_t rs, uint8_t m, uint8_t mode) {
+  switch (mode)
+  {
+    case SH1106_BLIT_COPY:
+      while(n--) { *d = (*d & ~m) | (((uint8_t)(*s++ << ls) >> rs) & m); d++; }
+      break;
+    case SH1106_BLIT_OR:
+      while(n--) { *d++ |= ((uint8_t)(*s++ << ls) >> rs) & m; }
+      break;
+    case SH1106_BLIT_AND:
+      m = ~m;
+      while(n--) { *d++ &= ((uint8_t)(*s++ << ls) >> rs) | m; }
+      break;
+    case SH1106_BLIT_XOR:
+      while(n--) { *d++ ^= ((uint8_t)(*s++ << ls) >> rs) & m; }
+      break;
+  }
+}
+
+// composite a page-layout canvas into the framebuffer with its top-left at
+// (x, y). Clipping is done once per blit and the canvas is merged a byte (8
+// rows) at a time, shifted into place when y is not a multiple of 8.
+// mode is SH1106_BLIT_COPY, _OR, _AND or _XOR. The canvas is copied as laid
+// out in its buffer (its own rotation only affects drawing into it); if the
+// display itself is rotated this falls back to drawPixel().
+void Adafruit_SH1106::drawCanvas(int16_t x, int16_t y, const GFXcanvas1V &canvas, uint8_t mode) {
+  const uint8_t *src = canvas.getBuffer();
+  if (!src || !buffer) return;
+
+  // raw canvas geometry
+  int16_t cw = canvas.width(), ch = canvas.height();
+  if (canvas.getRotation() & 1) swap(cw, ch);
+
+  markDirty(x, y, cw, ch);
+  if (SH1106_ROTATION != 0) {
+    dirtyHold++;
+    for (int16_t j = 0; j < ch; j++) {
+      for (int16_t i = 0; i < cw; i++) {
+        bool on = (src[i + (j/8)*cw] >> (j&7)) & 1;
+        switch (mode)
+        {
+          case SH1106_BLIT_COPY: drawPixel(x+i, y+j, on ? WHITE : BLACK); break;
+          case SH1106_BLIT_OR:   if (on)  drawPixel(x+i, y+j, WHITE);     break;
+          case SH1106_BLIT_AND:  if (!on) drawPixel(x+i, y+j, BLACK);     break;
+          case SH1106_BLIT_XOR:  if (on)  drawPixel(x+i, y+j, INVERSE);   break;
+        }
+      }
+    }
+    dirtyHold--;
+    return;
+  }
+
+  // clip columns to the display and clip rect
+  int16_t xe = min(SH1106_PANEL_WIDTH, clip_x2);
+  int16_t c0 = (x < clip_x1) ? clip_x1 - x : 0;
+  int16_t c1 = (x + cw > xe) ? xe - x : cw;
+  if (c0 >= c1) return;
+  int16_t ye = min(SH1106_PANEL_HEIGHT, clip_y2);
+
+  int16_t pages = (ch + 7) / 8;
+  int16_t page0 = (y >= 0) ? (y / 8) : -((7 - y) / 8); // floor(y / 8)
+  uint8_t shift = y - page0 * 8;
+
+  for (int16_t p = 0; p < pages; p++) {
+    // rows of this canvas page that are inside the canvas
+    uint8_t valid = ((p == pages - 1) && (ch & 7)) ? (0xFF >> (8 - (ch & 7))) : 0xFF;
+    const uint8_t *s = &src[p * cw + c0];
+    int16_t dp = page0 + p;
+
+    if ((dp >= 0) && (dp < SH1106_PANEL_HEIGHT / 8)) {
+      uint8_t m = (uint8_t)(valid << shift) & pageMask(dp, clip_y1, ye);
+      if (m) {
+        blitSpan(&buffer[dp * SH1106_PANEL_WIDTH + x + c0], s, c1 - c0,
+                 shift, 0, m, mode);
+      }
+    }
+    dp++;
+    if (shift && (dp >= 0) && (dp < SH1106_PANEL_HEIGHT / 8)) {
+      uint8_t m = (valid >> (8 - shift)) & pageMask(dp, clip_y1, ye);
+      if (m) {
+        blitSpan(&buffer[dp * SH1106_PANEL_WIDTH + x + c0], s, c1 - c0,
+                 0, 8 - shift, m, mode);
+      }
+    }
+  }
+}
+
+static inline void applyColor(uint8_t *d, uint8_t bits, uint16_t color) {
+  switch (color)
+  {
+    case WHITE:   *d |=  bits; break;
+    case BLACK:   *d &= ~bits; break;
+    case INVERSE: *d ^=  bits; break;
+  }
+}
+
+// drawBitmap() fast path: the clipped bitmap is walked in 8x8 tiles, each
+// tile transposed by GFXtranspose8x8() into 8 page-format column bytes and
+// merged into at most two display pages. Rotated displays use the generic per-pixel version.
+void Adafruit_SH1106::blitBitmap(int16_t x, int16_t y, const uint8_t *bitmap, int16_t w, int16_t h,
+                                 uint16_t color, uint16_t bg, bool transparent, bool progmem) {
+  if (!buffer) return;
+  if (SH1106_ROTATION != 0) {
+    Adafruit_GFX::blitBitmap(x, y, bitmap, w, h, color, bg, transparent, progmem);
+    return;
+  }
+
+  int16_t byteWidth = (w + 7) / 8;
+  int16_t xe = min(SH1106_PANEL_WIDTH, clip_x2), ye = min(SH1106_PANEL_HEIGHT, clip_y2);
+  int16_t i0 = (x < clip_x1) ? clip_x1 - x : 0, j0 = (y < clip_y1) ? clip_y1 - y : 0;
+  int16_t i1 = (x + w > xe) ? xe - x : w;
+  int16_t j1 = (y + h > ye) ? ye - y : h;
+  if ((i0 >= i1) || (j0 >= j1)) return;
+  markDirty(x + i0, y + j0, i1 - i0, j1 - j0);
+
+  for (int16_t jt = j0; jt < j1; jt += 8) {
+    // bitmap rows jt..jt+7 land on display rows from y+jt, which is >= 0
+    uint8_t vm = (j1 - jt >= 8) ? 0xFF : (0xFF >> (8 - (j1 - jt)));
+    uint8_t page = (y + jt) / 8, shift = (y + jt) & 7;
+    uint8_t *lo = &buffer[page * SH1106_PANEL_WIDTH];
+    uint8_t *hi = (shift && (page + 1 < SH1106_PANEL_HEIGHT / 8)) ? lo + SH1106_PANEL_WIDTH : NULL;
+
+    for (int16_t bx = i0 / 8; bx <= (i1 - 1) / 8; bx++) {
+      uint64_t t = 0;
+      for (uint8_t r = 0; (r < 8) && (jt + r < j1); r++) {
+        const uint8_t *src = &bitmap[(jt + r) * byteWidth + bx];
+        t |= (uint64_t)(progmem ? pgm_read_byte(src) : *src) << (r * 8);
+      }
+      t = GFXtranspose8x8(t);
+
+      int16_t c = bx * 8, cend = c + 8;
+      uint8_t k = 0;
+      if (c < i0) { k = i0 - c; c = i0; }
+      if (cend > i1) cend = i1;
+      for (; c < cend; c++, k++) {
+        uint8_t col = t >> ((7 - k) * 8);
+        uint8_t set = col & vm, clr = ~col & vm;
+        applyColor(&lo[x + c], set << shift, color);
+        if (!transparent) applyColor(&lo[x + c], clr << shift, bg);
+        if (hi) {
+          applyColor(&hi[x + c], set >> (8 - shift), color);
+          if (!transparent) applyColor(&hi[x + c], clr >> (8 - shift), bg);
+        }
+      }
+    }
+  }
+}
+
+// SH1106_PageBand ---------------------------------------------------------
+
+// no band yet, setBand() supplies one
+SH1106_PageBand::SH1106_PageBand(uint8_t w, uint8_t h) : Adafruit_GFX(w, h) {}
+
+// point the canvas at a page of the panel and fill it (BLACK or WHITE). The
+// clip rect is the page, in the current rotation's coordinates
+void SH1106_PageBand::setBand(uint8_t *buf, uint8_t p, uint16_t color) {
+  band = buf;
+  page = p;
+  int16_t top = p * 8;
+  switch (rotation) {
+    case 0:  setClipRect(0, top, _width, 8); break;
+    case 1:  setClipRect(top, 0, 8, _height); break;
+    case 2:  setClipRect(0, HEIGHT - top - 8, _width, 8); break;
+    default: setClipRect(HEIGHT - top - 8, 0, 8, _height); break;
+  }
+  memset(buf, (color == WHITE) ? 0xFF : 0x00, WIDTH);
+}
+
+// as Adafruit_SH1106::drawPixel(), into the band
+void SH1106_PageBand::drawPixel(int16_t x, int16_t y, uint16_t color) {
+  if ((x < 0) || (x >= _width) || (y < 0) || (y >= _height) || clipped(x, y))
+    return;
+  switch (rotation) {
+  case 1:
+    swap(x, y);
+    x = WIDTH - x - 1;
+    break;
+  case 2:
+    x = WIDTH - x - 1;
+    y = HEIGHT - y - 1;
+    break;
+  case 3:
+    swap(x, y);
+    y = HEIGHT - y - 1;
+    break;
+  }
+  switch (color)
+  {
+    case WHITE:   band[x] |=  (1 << (y&7)); break;
+    case BLACK:   band[x] &= ~(1 << (y&7)); break;
+    case INVERSE: band[x] ^=  (1 << (y&7)); break;
+  }
+}
+
+// lines are one-pixel rectangles; like the framebuffer versions, negative
+// sizes draw nothing
+void SH1106_PageBand::drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) {
+  fillRect(x, y, 1, h, color);
+}
+
+void SH1106_PageBand::drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) {
+  fillRect(x, y, w, 1, color);
+}
+
+// clipped to the page, a rectangle is a single masked span of the band
+void SH1106_PageBand::fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+  if ((w <= 0) || (h <= 0) || !clipRawRect(&x, &y, &w, &h)) return;
+  fillSpan(&band[x], w, pageMask(page, y, y + h), color);
+}
+
+// Adafruit_SH1106_Band ----------------------------------------------------
+
+// oled must have been given a panel; call begin() on both before drawing
+Adafruit_SH1106_Band::Adafruit_SH1106_Band(Adafruit_SH1106 &oled, uint16_t ops) :
+  GFXrecorder(oled.WIDTH, oled.HEIGHT, ops), oled(oled), canvas(oled.WIDTH, oled.HEIGHT) {
+#ifdef SH1106_FIXED_ROTATION
+  Adafruit_GFX::setRotation(SH1106_FIXED_ROTATION);
+#endif
+}
+
+Adafruit_SH1106_Band::~Adafruit_SH1106_Band(void) {
+  free(band);
+  if (frame && (oled.buffer == frame)) oled.buffer = NULL;
+  free(frame);
+}
+
+// allocate the primitive list and the band; false if out of memory
+bool Adafruit_SH1106_Band::begin(void) {
+  if (!beginOps()) return false;
+  if (!band && !(band = (uint8_t *)malloc(WIDTH))) return false;
+  clearDisplay();
+  return true;
+}
+
+#ifdef SH1106_FIXED_ROTATION
+// the orientation is fixed at build time, as for Adafruit_SH1106
+void Adafruit_SH1106_Band::setRotation(uint8_t r) {
+  (void)r;
+  Adafruit_GFX::setRotation(SH1106_FIXED_ROTATION);
+}
+#endif
+
+// BLACK or WHITE start the scene over from that background; INVERSE has to
+// flip what is already there, so it is kept as a rectangle
+void Adafruit_SH1106_Band::fillScreen(uint16_t color) {
+  if (color == INVERSE)
+    GFXrecorder::fillRect(0, 0, _width, _height, color);
+  else
+    GFXrecorder::fillScreen(color);
+}
+
+// the list is full: draw the rest of the frame into a whole framebuffer,
+// the panel's own if it was given one. It starts from the background with
+// the list replayed into it, and display() sends it as the panel would
+Adafruit_GFX *Adafruit_SH1106_Band::overflow(void) {
+  if (!oled.buffer && !(oled.buffer = frame = (uint8_t *)malloc(WIDTH * HEIGHT / 8)))
+    return NULL;
+  oled.setRotation(rotation);
+  oled.fillScreen(background);
+  return &oled;
+}
+
+// draw and send the frame a page at a time, in the order display() sends
+// them. Every page goes out each frame: without a copy of what is on the
+// panel there is nothing to compare against. The list is kept, so later
+// drawing adds to it as it would to a framebuffer
+void Adafruit_SH1106_Band::display(void) {
+  if (!band) return;
+  if (fallback()) {
+    oled.display();
+    return;
+  }
+  canvas.setRotation(rotation);
+  for (int8_t p = (HEIGHT/8)-1; p >= 0; p--) {
+    canvas.setBand(band, p, background);
+    replay(canvas);
+    if (!oled.sendPage(p, band)) return;
+  }
+}
@@ -34,21 +34,60 @@ All text above, and the splash screen must be included in any redistribution
 
 #include <SPI.h>
 #include <Adafruit_GFX.h>
+#include <Adafruit_I2CDevice.h>
+#include <Adafruit_GFX_Direct.h>
+#include <Adafruit_GFX_Recorder.h>
 
 #define BLACK 0
 #define WHITE 1
 #define INVERSE 2
 
+// merge modes for drawCanvas()
+#define SH1106_BLIT_COPY 0
+#define SH1106_BLIT_OR   1
+#define SH1106_BLIT_AND  2
+#define SH1106_BLIT_XOR  3
+
 #define SH1106_I2C_ADDRESS   0x3C	// 011110+SA0+RW - 0x3C or 0x3D
 // Address for 128x32 is 0x3C
 // Address for 128x64 is 0x3D (default) or 0x3C (if SA0 is grounded)
 
+// hardware SPI clock. The SH1106 is rated for 10 MHz (100 ns SCLK cycle);
+// a full frame is 1024 data + 24 command bytes, about 1.05 ms on the wire at
+// 8 MHz and 0.84 ms at 10 MHz
+#ifndef SH1106_SPI_FREQ
+  #define SH1106_SPI_FREQ 8000000
+#endif
+
+// I2C error handling: a transaction is given up after SH1106_I2C_TIMEOUT_MS,
+// and a failed bus is cleared and the panel re-initialised at most once
+// every SH1106_RECOVERY_INTERVAL_MS
+#ifndef SH1106_I2C_TIMEOUT_MS
+  #define SH1106_I2C_TIMEOUT_MS 10
+#endif
+#ifndef SH1106_RECOVERY_INTERVAL_MS
+  #define SH1106_RECOVERY_INTERVAL_MS 100
+#endif
+
+// I2C clock tuning (ESP32): begin() runs the bus at the fastest clock, up to
+// SH1106_I2C_MAX_CLOCK, at which the panel reads back what was written, and
+// keeps it in NVS. Define SH1106_NO_CLOCK_TUNING to leave the clock alone.
+// The limit defaults to the SH1106's rated 400 kHz; define it as 800000 or
+// 1000000 to let begin() try clocks beyond the rating as well.
+#ifndef SH1106_I2C_MAX_CLOCK
+  #define SH1106_I2C_MAX_CLOCK 400000
+#endif
+#if defined(ESP32) && !defined(SH1106_NO_CLOCK_TUNING)
+  #define SH1106_CLOCK_TUNING
+#endif
+
 /*=========================================================================
     SH1106 Displays
     -----------------------------------------------------------------------
     The driver is used in multiple displays (128x64, 128x32, etc.).
     Select the appropriate display below to create an appropriately
-    sized framebuffer, etc.
+    sized framebuffer, etc. This is the panel the constructors without an
+    SH1106_Panel argument drive; see SH1106_Panel below for others.
 
     SH1106_128_64  128x64 pixel display
 
@@ -82,6 +121,57 @@ All text above, and the splash screen must be included in any redistribution
   #define SH1106_LCDHEIGHT                 16
 #endif
 
+/*=========================================================================
+    Fixed rotation
+    -----------------------------------------------------------------------
+    Define SH1106_FIXED_ROTATION as 0-3 (below, or with -D in the build
+    flags) to build the pixel, line and blit code for that one orientation
+    only. setRotation() then always selects it. Leave it undefined to keep
+    the usual runtime rotation.
+    -----------------------------------------------------------------------*/
+//   #define SH1106_FIXED_ROTATION 0
+/*=========================================================================*/
+
+/*=========================================================================
+    Fixed panel size
+    -----------------------------------------------------------------------
+    The driver reads the panel size from the object, so that one build can
+    drive panels of several sizes (see SH1106_Panel below). Define
+    SH1106_FIXED_PANEL (below, or with -D in the build flags) to build it
+    for the panel selected above only, with its size as a constant; every
+    panel must then be that size. Together with SH1106_FIXED_ROTATION this
+    makes the bounds checks compile-time constants again.
+    -----------------------------------------------------------------------*/
+//   #define SH1106_FIXED_PANEL
+/*=========================================================================*/
+
+/*=========================================================================
+    Splash screen
+    -----------------------------------------------------------------------
+    By default the Adafruit splash screen is kept in flash, loaded into the
+    framebuffer by begin() and can be shown with showSplash(). Define
+    SH1106_NO_SPLASH (below, or with -D in the build flags) to leave it
+    out and start from a blank framebuffer.
+    -----------------------------------------------------------------------*/
+//   #define SH1106_NO_SPLASH
+/*=========================================================================*/
+
+/*=========================================================================
+    Shadow buffer
+    -----------------------------------------------------------------------
+    display() sends the pages drawing has touched since the last call.
+    Define SH1106_SHADOW_BUFFER (below, or with -D in the build flags) to
+    also keep a copy of the framebuffer as last sent, WIDTH * HEIGHT / 8
+    more bytes per panel, so that touched pages which came out the same
+    are not sent again. Worth it when most frames redraw pixels unchanged.
+    -----------------------------------------------------------------------*/
+//   #define SH1106_SHADOW_BUFFER
+/*=========================================================================*/
+
+#if defined SH1106_FIXED_ROTATION && ((SH1106_FIXED_ROTATION < 0) || (SH1106_FIXED_ROTATION > 3))
+  #error "SH1106_FIXED_ROTATION must be 0, 1, 2 or 3"
+#endif
+
 #define SH1106_SETCONTRAST 0x81
 #define SH1106_DISPLAYALLON_RESUME 0xA4
 #define SH1106_DISPLAYALLON 0xA5
@@ -103,6 +193,10 @@ All text above, and the splash screen must be included in any redistribution
 #define SH1106_SETLOWCOLUMN 0x02 //to use with SSD1306, set to 0x00
 #define SH1106_SETHIGHCOLUMN 0x10
 
+// the controller has 132 columns of RAM; the panel's column 0 is wired to
+// this one (2 on the usual 128 column modules)
+#define SH1106_COLUMN_OFFSET SH1106_SETLOWCOLUMN
+
 #define SH1106_SETSTARTLINE 0x40
 
 #define SH1106_MEMORYMODE 0x20
@@ -128,21 +222,71 @@ All text above, and the splash screen must be included in any redistribution
 #define SH1106_VERTICAL_AND_RIGHT_HORIZONTAL_SCROLL 0x29
 #define SH1106_VERTICAL_AND_LEFT_HORIZONTAL_SCROLL 0x2A
 
+// geometry and framebuffer storage of a panel, for drivers of a size other
+// than the one selected above (several can run side by side). width is at
+// most 132 - colOffset, height a multiple of 8 up to 64; colOffset is the
+// RAM column the panel's column 0 is wired to. buffer and shown are
+// width * height / 8 bytes each, e.g. from SH1106_PanelBuffers or an arena,
+// or both NULL for a panel drawn through an Adafruit_SH1106_Band. shown is
+// the optional shadow copy (see SH1106_SHADOW_BUFFER), NULL to go without
+typedef struct {
+  uint8_t width, height, colOffset;
+  uint8_t *buffer, *shown;
+} SH1106_Panel;
+
+// framebuffer storage for one W x H panel, sized at compile time. Declare
+// one per display at file scope (so it goes in .bss) and pass it to the
+// constructor:
+//   SH1106_PanelBuffers<128, 32> smallPanel;
+//   Adafruit_SH1106 small(smallPanel, 21, 22);
+template <uint8_t W, uint8_t H, uint8_t COLOFFSET = SH1106_COLUMN_OFFSET>
+class SH1106_PanelBuffers {
+  static_assert((H % 8 == 0) && (H > 0) && (H <= 64), "SH1106 panel height must be 8-64, a multiple of 8");
+  static_assert((W > 0) && (W + COLOFFSET <= 132), "SH1106 panel must fit in the 132 RAM columns");
+#ifdef SH1106_FIXED_PANEL
+  static_assert((W == SH1106_LCDWIDTH) && (H == SH1106_LCDHEIGHT), "SH1106_FIXED_PANEL: panel must be the size selected in Adafruit_SH1106.h");
+#endif
+ public:
+  operator SH1106_Panel() {
+#ifdef SH1106_SHADOW_BUFFER
+    SH1106_Panel p = { W, H, COLOFFSET, buffer, shown };
+#else
+    SH1106_Panel p = { W, H, COLOFFSET, buffer, NULL };
+#endif
+    return p;
+  }
+ private:
+  uint8_t buffer[W * H / 8];
+#ifdef SH1106_SHADOW_BUFFER
+  uint8_t shown[W * H / 8];
+#endif
+};
+
 class Adafruit_SH1106 : public Adafruit_GFX {
  public:
   Adafruit_SH1106(int8_t SID, int8_t SCLK, int8_t DC, int8_t RST, int8_t CS);
-  Adafruit_SH1106(int8_t DC, int8_t RST, int8_t CS);
+  Adafruit_SH1106(int8_t DC, int8_t RST, int8_t CS, uint32_t freq = SH1106_SPI_FREQ);
 
   Adafruit_SH1106(uint8_t RST);
   Adafruit_SH1106(int8_t SDA=-1, int8_t SCL=-1);
 
+  // the same for a panel of another size
+  Adafruit_SH1106(const SH1106_Panel &panel, int8_t SID, int8_t SCLK, int8_t DC, int8_t RST, int8_t CS);
+  Adafruit_SH1106(const SH1106_Panel &panel, int8_t DC, int8_t RST, int8_t CS, uint32_t freq = SH1106_SPI_FREQ);
+  Adafruit_SH1106(const SH1106_Panel &panel, int8_t SDA=-1, int8_t SCL=-1);
+  ~Adafruit_SH1106(void);
+
   void begin(uint8_t switchvcc = SH1106_SWITCHCAPVCC, uint8_t i2caddr = SH1106_I2C_ADDRESS, bool reset=true);
   void sh1106_command(uint8_t c);
+  void sh1106_commandList(const uint8_t *c, uint8_t n);
   void sh1106_data(uint8_t c);
 
   void clearDisplay(void);
   void invertDisplay(uint8_t i);
   void display();
+#ifndef SH1106_NO_SPLASH
+  void showSplash(void);
+#endif
 
   void startscrollright(uint8_t start, uint8_t stop);
   void startscrollleft(uint8_t start, uint8_t stop);
@@ -151,17 +295,75 @@ class Adafruit_SH1106 : public Adafruit_GFX {
   void startscrolldiagleft(uint8_t start, uint8_t stop);
   void stopscroll(void);
 
+  // I2C health: transactions that failed, bus recoveries run, the last
+  // error (Wire's endTransmission() status: 2 address NACK, 3 data NACK,
+  // 4 other, 5 timeout; 0 if none yet) and whether the bus is currently
+  // usable
+  uint32_t getI2CErrors(void) { return i2cErrors; }
+  uint32_t getBusRecoveries(void) { return busRecoveries; }
+  uint8_t getLastI2CError(void) { return lastI2CError; }
+  bool busOK(void) { return !busFailed; }
+  // the I2C clock in use, 0 if left at the Wire default
+  uint32_t getI2CClock(void) { return i2cClock; }
+#ifdef SH1106_CLOCK_TUNING
+  void tuneI2CClock(bool force = false);
+#endif
+
   void dim(boolean dim);
+  void setContrast(uint8_t contrast);
+  uint8_t getInitContrast(void);
+  void setStartLine(uint8_t line);
 
   void drawPixel(int16_t x, int16_t y, uint16_t color);
+#ifdef SH1106_FIXED_ROTATION
+  void setRotation(uint8_t r);
+#endif
 
   virtual void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color);
   virtual void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color);
+  virtual void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+  void drawCanvas(int16_t x, int16_t y, const GFXcanvas1V &canvas, uint8_t mode = SH1106_BLIT_COPY);
+  virtual void blitBitmap(int16_t x, int16_t y, const uint8_t *bitmap, int16_t w, int16_t h,
+                          uint16_t color, uint16_t bg, bool transparent, bool progmem);
 
  private:
   int8_t _i2caddr, _vccstate, sid, sclk, dc, cs, sda, scl;
   uint8_t rst;
+
+  uint8_t *buffer;      // framebuffer, WIDTH * HEIGHT / 8 bytes
+  uint8_t *shown;       // copy of it as last sent or NULL, see changedPages()
+  uint8_t shownValid;   // bit per page that shown matches the panel for
+  uint8_t colOffset;    // first controller RAM column of the panel
+
   void fastSPIwrite(uint8_t c);
+  void spiWrite(const uint8_t *d, uint16_t n);
+  void commandBytes(const uint8_t *c, uint8_t n, bool progmem);
+  void sendPages(const uint8_t *src, uint8_t pages, bool progmem, uint16_t stride);
+  bool sendPage(uint8_t page, const uint8_t *data);
+  uint8_t dirtyPages(void);
+  uint8_t changedPages(void);
+  void sendInit(void);
+  void beginWire(void);
+  bool i2cSend(uint8_t control, const uint8_t *d, uint16_t n, uint16_t chunk);
+  bool i2cData(const uint8_t *d, uint16_t n);
+  bool recoverBus(void);
+  void clearBus(void);
+#ifdef SH1106_CLOCK_TUNING
+  bool clockWorks(void);
+#endif
+
+  bool busFailed = false;         // an I2C transaction failed, see i2cSend()
+  uint8_t lastI2CError = 0;
+  uint32_t i2cErrors = 0, busRecoveries = 0;
+  unsigned long recoverAt = 0;    // millis() from which recoverBus() may run
+  uint32_t i2cClock = 0;          // tuned I2C clock, 0 = Wire default
+  Adafruit_I2CDevice *i2c_dev = NULL;   // all I2C traffic, see i2cSend()
+
+  // the last contrast, start line and inversion set, see sendInit()
+  uint8_t contrastLevel = 0, startLine = 0;
+  bool inverted = false;
+
+  SPISettings spiSettings;
 
   boolean hwSPI;
   #ifndef ESP32
@@ -175,4 +377,74 @@ class Adafruit_SH1106 : public Adafruit_GFX {
   inline void drawFastVLineInternal(int16_t x, int16_t y, int16_t h, uint16_t color) __attribute__((always_inline));
   inline void drawFastHLineInternal(int16_t x, int16_t y, int16_t w, uint16_t color) __attribute__((always_inline));
 
+  friend class Adafruit_SH1106_Band;
+};
+
+// one 8-row page of a panel, as a canvas: drawing takes whole-screen
+// coordinates (in the current rotation) and lands in a WIDTH byte band laid
+// out like a page of the framebuffer. The page is the clip rect, so
+// primitives that miss it are rejected whole
+class SH1106_PageBand : public Adafruit_GFX {
+ public:
+  SH1106_PageBand(uint8_t w, uint8_t h);
+  void setBand(uint8_t *buf, uint8_t page, uint16_t color);
+  void drawPixel(int16_t x, int16_t y, uint16_t color);
+  void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color);
+  void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color);
+  void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+
+ private:
+  uint8_t *band = NULL;
+  uint8_t page = 0;
+};
+
+// framebuffer-less rendering. Drawing is recorded as a list of primitives
+// (see Adafruit_GFX_Recorder.h) and display() replays it into one 128 byte
+// band per page, sending each page as soon as it is drawn. The pixels are
+// the ones the framebuffer would hold. Give the Adafruit_SH1106 a panel
+// without buffers and draw through this object only:
+//   SH1106_Panel bare = { 128, 64, SH1106_COLUMN_OFFSET, NULL, NULL };
+//   Adafruit_SH1106 oled(bare, 21, 22);
+//   Adafruit_SH1106_Band display(oled);
+//   oled.begin(SH1106_SWITCHCAPVCC, 0x3C); display.begin();
+// RAM is the band (WIDTH bytes) plus a list of ops 8 byte entries, 256
+// bytes in all at the defaults; a RoboEyes frame takes 14 entries. A frame
+// that needs more falls back to a whole framebuffer (WIDTH * HEIGHT / 8
+// bytes, allocated the first time and kept) until the next clear. The
+// rotation in effect at display() applies to the whole frame
+class Adafruit_SH1106_Band : public GFXrecorder {
+ public:
+  Adafruit_SH1106_Band(Adafruit_SH1106 &oled, uint16_t ops = 16);
+  ~Adafruit_SH1106_Band(void);
+
+  bool begin(void);
+  void display(void);
+  void fillScreen(uint16_t color);
+#ifdef SH1106_FIXED_ROTATION
+  void setRotation(uint8_t r);
+#endif
+
+  // hardware effects go straight to the panel
+  void invertDisplay(bool i) { oled.invertDisplay(i); }
+  void setContrast(uint8_t contrast) { oled.setContrast(contrast); }
+  uint8_t getInitContrast(void) { return oled.getInitContrast(); }
+  void setStartLine(uint8_t line) { oled.setStartLine(line); }
+
+ protected:
+  Adafruit_GFX *overflow(void);
+
+ private:
+  Adafruit_SH1106 &oled;
+  SH1106_PageBand canvas;   // replays the list into band
+  uint8_t *band = NULL;     // one page, WIDTH bytes
+  uint8_t *frame = NULL;    // framebuffer allocated by overflow(), if any
+};
+
+// record each primitive once rather than as spans
+template <>
+class Adafruit_GFX_Direct<Adafruit_SH1106_Band>
+    : public GFXrecorderDirect<Adafruit_SH1106_Band> {
+ public:
+  Adafruit_GFX_Direct(Adafruit_SH1106_Band &display)
+      : GFXrecorderDirect<Adafruit_SH1106_Band>(display) {}
 };
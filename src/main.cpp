@@ -16,6 +16,7 @@ Adafruit_SH1106 display(21, 22);  // SDA, SCL pins for ESP32
 RoboEyes<Adafruit_SH1106> roboEyes(display); // create RoboEyes instance
 
 const int BUTTON = 4;
+const unsigned long OLED_POWERUP_MS = 250; // OLED power-up time after reset
 bool animationActive = false;
 unsigned long previousMillis = 0;
 int animationStep = 0;
@@ -26,15 +27,9 @@ void resetEyes();
 void setup() {
   Serial.begin(9600);
   pinMode(BUTTON, INPUT_PULLUP);
-  
-  delay(250); // wait for the OLED to power up
-  display.begin(SH1106_SWITCHCAPVCC, i2c_Address); // Initialize display
-  display.clearDisplay();
-  
-  // Startup robo eyes with smooth framerate
-  roboEyes.begin(SCREEN_WIDTH, SCREEN_HEIGHT, 60); // 60fps for ultra-smooth animations
 
-  // Default settings - eyes closed initially
+  // Default settings - eyes closed initially. These only set up RoboEyes
+  // state, so they run while the OLED is still powering up
   roboEyes.setAutoblinker(OFF, 3, 2);
   roboEyes.setIdleMode(OFF, 2, 2);
   
@@ -57,10 +52,21 @@ void setup() {
   roboEyes.setAngryVein(OFF);
   roboEyes.setHFlicker(OFF, 2);
   roboEyes.setVFlicker(OFF, 2);
+
+  // wait for the OLED to power up, counted from reset rather than from here
+  while (millis() < OLED_POWERUP_MS) yield();
+  display.begin(SH1106_SWITCHCAPVCC, i2c_Address, false); // Initialize display (no reset line on I2C modules)
   
-  display.clearDisplay();
-  display.display();
-  
+  // Startup robo eyes with smooth framerate; this clears the screen
+  roboEyes.begin(SCREEN_WIDTH, SCREEN_HEIGHT, 60); // 60fps for ultra-smooth animations
+
+  // draw the first eye frame (closed eyes) here rather than on the first
+  // button press, so the serial line gives the time from reset to it
+  roboEyes.drawEyes();
+  Serial.print("First frame at ");
+  Serial.print(millis());
+  Serial.println(" ms");
+
   Serial.println("🤖 RoboEyes Natural Life - Press button to begin");
 } // end of setup
 